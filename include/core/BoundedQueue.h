@@ -0,0 +1,98 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// Blocking FIFO with a capacity, for handing work between pipeline stages.
+// Push() waits while the queue is full, so a fast stage can't run ahead of a
+// slow one; Pop() waits while it is empty. Close() wakes everyone: pushes
+// fail from then on and pops drain what is left, then return nothing.
+template<typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(const size_t capacity) : m_capacity(capacity == 0 ? 1 : capacity) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // False (and the item dropped) if the queue was closed
+    bool Push(T item) {
+        std::unique_lock lock(m_mutex);
+        m_notFull.wait(lock, [this] { return m_closed || m_items.size() < m_capacity; });
+        if (m_closed) return false;
+
+        m_items.push_back(std::move(item));
+        lock.unlock();
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    // Empty once the queue is closed and drained
+    std::optional<T> Pop() {
+        std::unique_lock lock(m_mutex);
+        m_notEmpty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+        if (m_items.empty()) return std::nullopt;
+
+        T item = std::move(m_items.front());
+        m_items.pop_front();
+        lock.unlock();
+        m_notFull.notify_one();
+        return item;
+    }
+
+    // Waits for at least one item, then takes up to maxItems without waiting
+    // further. Zero once the queue is closed and drained.
+    size_t PopBatch(std::vector<T>& out, const size_t maxItems) {
+        std::unique_lock lock(m_mutex);
+        m_notEmpty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+
+        size_t taken = 0;
+        while (!m_items.empty() && taken < maxItems) {
+            out.push_back(std::move(m_items.front()));
+            m_items.pop_front();
+            taken++;
+        }
+        lock.unlock();
+        if (taken > 0) m_notFull.notify_all();
+        return taken;
+    }
+
+    // Removes everything queued and hands it back (e.g. to report cancellation)
+    std::vector<T> Drain() {
+        std::vector<T> drained;
+        {
+            std::lock_guard lock(m_mutex);
+            drained.reserve(m_items.size());
+            for (auto& item : m_items) drained.push_back(std::move(item));
+            m_items.clear();
+        }
+        m_notFull.notify_all();
+        return drained;
+    }
+
+    void Close() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_closed = true;
+        }
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+    }
+
+    size_t Size() const {
+        std::lock_guard lock(m_mutex);
+        return m_items.size();
+    }
+
+private:
+    const size_t            m_capacity;
+    std::deque<T>           m_items;
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    bool                    m_closed = false;
+};
@@ -60,6 +60,10 @@ enum class AudioMode {
     Mixed, Separated, Virtual
 };
 
+enum class HwDecodeMode {
+    Auto, VAAPI, Off
+};
+
 namespace fs = std::filesystem;
 // ──────────────────────────────────────────────────────────────────────────
 
@@ -71,6 +75,10 @@ struct Config {
     bool startMinimized                         = false;
     std::string libraryPath;
 
+    // ─── DECODING ─────────────────────────────────────────────────────────
+    HwDecodeMode hwDecode                       = HwDecodeMode::Auto;
+    std::string hwDecodeDevice                  = "";           // VAAPI render node, empty = default
+
     // ─── RECORDING SETTINGS ───────────────────────────────────────────────
     std::string recordingMode                   = "native";     // "obs" or "native"
     bool recordingAutoStart                     = false;
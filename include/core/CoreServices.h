@@ -5,6 +5,7 @@
 #include "core/Config.h"
 #include "core/library/VideoLibrary.h"
 #include "core/library/VideoDatabase.h"
+#include "core/library/LibraryWatcher.h"
 #include "core/import/VideoImportService.h"
 #include "core/recording/RecordingManager.h"
 
@@ -41,6 +42,10 @@ public:
         return GetService(m_videoImportService);
     }
 
+    LibraryWatcher* GetLibraryWatcher() {
+        return GetService(m_libraryWatcher);
+    }
+
     void Initialize();
     void Shutdown();
 
@@ -49,8 +54,8 @@ private:
     void InitializeInternal();
 
     // Template method
-    template<typename T>
-    T* GetService(std::unique_ptr<T>& service) {
+    template<typename Ptr>
+    auto GetService(Ptr& service) -> decltype(service.get()) {
         std::lock_guard lock(m_mutex);
         if (!m_initialized) InitializeInternal();
         return service.get();
@@ -59,8 +64,9 @@ private:
     // Member variables
     std::unique_ptr<Config> m_config;
     std::unique_ptr<VideoLibrary> m_videoLibrary;
-    std::unique_ptr<VideoDatabase> m_videoDatabase;
+    std::shared_ptr<VideoDatabase> m_videoDatabase;   // the one connection to library.db; the library shares it
     std::unique_ptr<VideoImportService> m_videoImportService;
+    std::unique_ptr<LibraryWatcher> m_libraryWatcher;
     std::unique_ptr<RecordingManager> m_recordingManager;
 
     std::recursive_mutex m_mutex;
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+// Lock-free ring buffer for events crossing from worker threads to the render
+// thread. Any number of threads Post(); one thread (the UI) Drain()s once per
+// frame. Posting never blocks and never allocates beyond the item itself: a
+// full queue drops the event and counts it, so a flood of progress updates
+// can't stall a worker behind a slow frame.
+//
+// Each slot carries a sequence number (Vyukov's bounded queue): a producer
+// claims a position with one CAS on the tail, fills the slot and publishes it
+// by bumping the sequence; the consumer takes slots in order as they appear.
+template<typename T>
+class EventQueue {
+public:
+    // Rounded up to a power of two
+    explicit EventQueue(const size_t capacity)
+        : m_mask(std::bit_ceil(capacity < 2 ? size_t{2} : capacity) - 1),
+          m_slots(std::make_unique<Slot[]>(m_mask + 1)) {
+        for (size_t i = 0; i <= m_mask; i++) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    // Any thread. False (and the event dropped) if the queue is full.
+    bool Post(T event) {
+        size_t position = m_tail.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        while (true) {
+            slot = &m_slots[position & m_mask];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (lag == 0) {
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (lag < 0) {
+                // The consumer hasn't freed this slot yet: a whole lap behind
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->value = std::move(event);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only
+    std::optional<T> TryPop() {
+        Slot& slot = m_slots[m_head & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != m_head + 1) return std::nullopt;
+
+        std::optional<T> event = std::move(slot.value);
+        slot.value.reset();
+        slot.sequence.store(m_head + m_mask + 1, std::memory_order_release);
+        m_head++;
+        return event;
+    }
+
+    // Consumer thread only. Hands every event already posted to handler, in
+    // order; at most one lap, so producers can't keep a frame here forever.
+    template<typename Handler>
+    size_t Drain(Handler&& handler) {
+        size_t handled = 0;
+        while (handled <= m_mask) {
+            auto event = TryPop();
+            if (!event) break;
+            handler(std::move(*event));
+            handled++;
+        }
+        return handled;
+    }
+
+    // Consumer thread only; drops whatever is waiting
+    void Clear() {
+        while (TryPop()) {}
+    }
+
+    size_t GetCapacity() const { return m_mask + 1; }
+    uint64_t GetDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        std::optional<T>    value;
+    };
+
+    const size_t            m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+
+    alignas(64) std::atomic<size_t> m_tail{0};   // producers
+    alignas(64) size_t m_head = 0;               // consumer
+    std::atomic<uint64_t> m_dropped{0};
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <sys/stat.h>
+
+// Cheap identity of a file on disk: if inode, size and mtime all match what
+// was stored, the file is assumed unchanged and is not probed again.
+struct FileFingerprint {
+    uint64_t inode   = 0;
+    int64_t  size    = 0;
+    int64_t  mtimeNs = 0;
+
+    bool IsValid() const { return inode != 0 || mtimeNs != 0; }
+
+    bool operator==(const FileFingerprint&) const = default;
+
+    static std::optional<FileFingerprint> Read(const std::string& path) {
+        struct stat st{};
+        if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) return std::nullopt;
+
+        FileFingerprint fp;
+        fp.inode   = static_cast<uint64_t>(st.st_ino);
+        fp.size    = static_cast<int64_t>(st.st_size);
+        fp.mtimeNs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec;
+        return fp;
+    }
+};
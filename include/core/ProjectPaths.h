@@ -9,6 +9,7 @@ struct ProjectPaths {
 
     std::filesystem::path dbPath;
     std::filesystem::path thumbFolder;
+    std::filesystem::path keyframeFolder;
 
     static ProjectPaths FromFolder(const std::filesystem::path& folder) {
         ProjectPaths p;
@@ -16,6 +17,7 @@ struct ProjectPaths {
         p.momentFolder = folder / ".moment";
         p.dbPath = p.momentFolder / "library.db";
         p.thumbFolder = p.momentFolder / "thumbnails";
+        p.keyframeFolder = p.momentFolder / "keyframes";
         return p;
     }
 
@@ -23,6 +25,7 @@ struct ProjectPaths {
         try {
             std::filesystem::create_directories(momentFolder);
             std::filesystem::create_directories(thumbFolder);
+            std::filesystem::create_directories(keyframeFolder);
             return true;
         } catch (const std::filesystem::filesystem_error& e) {
             std::cerr << "[ProjectPaths] Failed: " << e.what() << std::endl;
@@ -41,4 +44,8 @@ struct ProjectPaths {
     std::filesystem::path GetThumbPath(const std::string& filename) const {
         return thumbFolder / filename;
     }
+
+    std::filesystem::path GetKeyframeIndexPath(const std::filesystem::path& videoPath) const {
+        return keyframeFolder / (videoPath.stem().string() + ".kfi");
+    }
 };
\ No newline at end of file
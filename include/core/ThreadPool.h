@@ -0,0 +1,80 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads fed from a FIFO queue. Submit() hands back a
+// future per task; the destructor finishes whatever is queued, then joins.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threadCount) {
+        if (threadCount == 0) threadCount = 1;
+        m_workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; i++)
+            m_workers.emplace_back([this] { WorkerLoop(); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_cv.notify_all();
+        for (auto& worker : m_workers) {
+            if (worker.joinable()) worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template<typename F>
+    auto Submit(F&& task) -> std::future<std::invoke_result_t<F>> {
+        using Result = std::invoke_result_t<F>;
+
+        // std::function needs a copyable target, packaged_task isn't
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        auto future = packaged->get_future();
+        {
+            std::lock_guard lock(m_mutex);
+            m_tasks.emplace([packaged] { (*packaged)(); });
+        }
+        m_cv.notify_one();
+        return future;
+    }
+
+    size_t GetThreadCount() const { return m_workers.size(); }
+
+    size_t GetPendingCount() const {
+        std::lock_guard lock(m_mutex);
+        return m_tasks.size();
+    }
+
+private:
+    void WorkerLoop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(m_mutex);
+                m_cv.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+                if (m_stopping && m_tasks.empty()) return;
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread>          m_workers;
+    std::queue<std::function<void()>> m_tasks;
+    mutable std::mutex                m_mutex;
+    std::condition_variable           m_cv;
+    bool                              m_stopping = false;
+};
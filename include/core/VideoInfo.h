@@ -1,8 +1,10 @@
 #pragma once
 
-#include <filesystem>
+#include "core/FileFingerprint.h"
 
-#include <imgui.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
 #include <vector>
 
 struct VideoInfo {
@@ -14,6 +16,7 @@ struct VideoInfo {
     std::string name{};
     int64_t fileSize{};
     int64_t lastModified{};
+    FileFingerprint fingerprint{};   // as of the last scan; drives incremental sync
 
     // Video Data
     double durationSec{};
@@ -22,7 +25,6 @@ struct VideoInfo {
     int resolutionHeight{};
 
     // Application Logic
-    mutable ImTextureID thumbnailId = reinterpret_cast<ImTextureID>(nullptr);
     std::string thumbnailPath{};
     bool isFavorite = false;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/BoundedQueue.h"
 #include "core/VideoInfo.h"
 
 #include <string>
@@ -7,10 +8,12 @@
 #include <functional>
 #include <thread>
 #include <mutex>
-#include <queue>
+#include <memory>
 #include <atomic>
+#include <condition_variable>
 
 class VideoLibrary;
+class MediaProbe;
 
 enum class ImportStatus {
     SCANNING,
@@ -30,14 +33,29 @@ struct ImportProgress {
 
 using ProgressCallback = std::function<void(const ImportProgress&)>;
 
+// Worker counts per stage and the size of the queues between them. Probing and
+// embedding are disk-bound, thumbnails CPU/GPU-bound, and one writer batches
+// the database inserts into transactions.
+struct ImportPipelineConfig {
+    size_t probeWorkers     = 2;
+    size_t thumbnailWorkers = 0;    // 0 = half the cores
+    size_t embedWorkers     = 2;
+    size_t queueCapacity    = 16;   // per stage; bounds how many files are open at once
+    size_t dbBatchSize      = 32;
+};
+
+// Imports run as a pipeline: probe → thumbnail → embed → database, each stage
+// with its own threads and a bounded queue feeding the next, so a bulk import
+// keeps every stage busy instead of finishing one file before starting the next.
 class VideoImportService {
 public:
-    VideoImportService();
+    explicit VideoImportService(const ImportPipelineConfig& config = {});
     ~VideoImportService();
 
     VideoImportService(const VideoImportService&) = delete;
     VideoImportService& operator=(const VideoImportService&) = delete;
 
+    // Never blocks; callbacks run on the pipeline's threads
     void ImportVideo(
         const std::string& videoPath,
         VideoLibrary* library,
@@ -56,6 +74,7 @@ public:
         const ProgressCallback& callback = nullptr
     );
 
+    // Files queued or still inside the pipeline
     bool IsImporting() const;
     size_t GetQueueSize() const;
     void CancelImport();
@@ -71,13 +90,46 @@ private:
         ProgressCallback callback;
     };
 
-    void ImportWorkerThread();
-    void ProcessImportTask(const ImportTask& task);
-    VideoInfo ScanVideoWithFFmpeg(const std::string& videoPath);
+    // What travels between stages; the probe stays open until the embed stage
+    // so the thumbnail decodes from the same open
+    struct ImportItem {
+        ImportTask                  task;
+        uint64_t                    generation = 0;
+        std::unique_ptr<MediaProbe> probe;
+        VideoInfo                   info;
+        bool                        hasEmbedded = false;
+    };
+
+    using ItemQueue = BoundedQueue<ImportItem>;
+
+    // Stages: false when the item failed (already reported)
+    bool ProbeStage(ImportItem& item) const;
+    bool ThumbnailStage(ImportItem& item) const;
+    bool EmbedStage(ImportItem& item) const;
+    void DatabaseWriter();
+
+    void StageWorker(ItemQueue& input, ItemQueue& output, bool (VideoImportService::*stage)(ImportItem&) const);
 
-    std::queue<ImportTask> m_importQueue;
-    std::thread m_importWorker;
-    mutable std::mutex m_queueMutex;
-    std::atomic<bool> m_isRunning;
-    std::atomic<bool> m_cancelRequested;
-};
\ No newline at end of file
+    static void Report(const ImportItem& item, ImportStatus status, float progress, const std::string& message);
+    void Fail(const ImportItem& item, const std::string& error);
+    void Finish();   // one file left the pipeline
+
+    static VideoInfo ScanVideoWithFFmpeg(const MediaProbe& probe);
+
+    ImportPipelineConfig m_config;
+
+    ItemQueue m_pending;          // unbounded intake: just paths
+    ItemQueue m_probed;
+    ItemQueue m_thumbnailed;
+    ItemQueue m_embedded;
+
+    std::atomic<uint64_t> m_generation{0};   // bumped by CancelImport
+    size_t                m_inFlight = 0;
+    mutable std::mutex    m_inFlightMutex;
+    mutable std::condition_variable m_idle;
+
+    std::vector<std::thread> m_probeWorkers;
+    std::vector<std::thread> m_thumbnailWorkers;
+    std::vector<std::thread> m_embedWorkers;
+    std::thread              m_dbWriter;
+};
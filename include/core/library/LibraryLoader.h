@@ -10,7 +10,19 @@ class LibraryLoader {
 public:
     using ProgressCallback = std::function<void(const std::string&, float)>;
 
+    // Syncs the whole folder: only files whose fingerprint changed are processed.
+    // Touches changed rows only, so the grid can show as soon as it returns.
     static void Run(VideoLibrary* library, 
                     const std::string& libraryPath,
                     const ProgressCallback &onProgress = nullptr);
+
+    // What used to hold up the loading screen: integrity check, missing
+    // thumbnails and the atlas repack. Reads every row; run it in the background.
+    static void RunMaintenance(VideoLibrary* library,
+                               const ProgressCallback& onProgress = nullptr);
+
+    // Same, for one file (e.g. a clip that was just saved); false if nothing changed
+    static bool SyncFile(VideoLibrary* library,
+                         const std::string& videoPath,
+                         const ProgressCallback& onProgress = nullptr);
 };
\ No newline at end of file
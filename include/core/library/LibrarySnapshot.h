@@ -0,0 +1,49 @@
+#pragma once
+
+#include "core/VideoInfo.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One immutable version of the library's records, sorted by file path.
+// VideoDatabase builds a new version on every write and publishes it
+// atomically; readers keep whichever version they loaded for as long as they
+// hold the pointer, and iterate it without locks or copies. Records are
+// shared between versions, so a write only allocates the rows it changed.
+class LibrarySnapshot {
+public:
+    using VideoPtr = std::shared_ptr<const VideoInfo>;
+
+    LibrarySnapshot() = default;
+
+    // videos must be sorted by filePathString, without duplicates
+    LibrarySnapshot(const uint64_t version, std::vector<VideoPtr> videos)
+        : m_version(version), m_videos(std::move(videos)) {}
+
+    uint64_t GetVersion() const { return m_version; }
+    size_t Size() const { return m_videos.size(); }
+    bool Empty() const { return m_videos.empty(); }
+
+    const std::vector<VideoPtr>& GetVideos() const { return m_videos; }
+    auto begin() const { return m_videos.begin(); }
+    auto end() const { return m_videos.end(); }
+
+    // Null if the path has no record in this version
+    VideoPtr Find(const std::string& filePath) const {
+        const auto it = LowerBound(m_videos, filePath);
+        return it != m_videos.end() && (*it)->filePathString == filePath ? *it : nullptr;
+    }
+
+    static std::vector<VideoPtr>::const_iterator LowerBound(const std::vector<VideoPtr>& videos,
+                                                            const std::string& filePath) {
+        return std::ranges::lower_bound(videos, filePath, {},
+                                        [](const VideoPtr& video) -> const std::string& { return video->filePathString; });
+    }
+
+private:
+    uint64_t              m_version = 0;
+    std::vector<VideoPtr> m_videos;
+};
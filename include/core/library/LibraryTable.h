@@ -0,0 +1,52 @@
+#pragma once
+
+#include "core/VideoInfo.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Compact copy of the grid's loaded pages. Text lives in a single arena; a
+// path is stored as an interned folder id plus its file name, so a clip costs
+// tens of bytes here instead of a VideoInfo's several heap strings. Rows are
+// addressed by RowId (an index into every column) and only ever appended, a
+// page at a time, in display order.
+class LibraryTable {
+public:
+    using RowId = uint32_t;
+
+    LibraryTable() = default;
+
+    // Copies the fields the table keeps; returns the new row
+    RowId Append(const VideoInfo& video);
+
+    size_t Size() const { return m_names.size(); }
+    bool Empty() const { return m_names.empty(); }
+
+    std::string_view GetName(RowId row) const { return Text(m_names[row]); }
+    std::string GetPath(RowId row) const;
+    std::string GetThumbnailPath(RowId row) const;   // empty if none
+    bool HasThumbnail(RowId row) const { return m_thumbnailNames[row].length > 0; }
+
+private:
+    struct TextRef {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    std::string_view Text(const TextRef ref) const { return {m_arena.data() + ref.offset, ref.length}; }
+    TextRef AppendText(std::string_view text);
+    uint32_t InternFolder(std::string_view folder);
+
+    std::string          m_arena;     // every name and folder, back to back
+    std::vector<TextRef> m_folders;   // interned; clips usually share one or two
+    std::unordered_map<std::string, uint32_t> m_folderIds;
+
+    std::vector<uint32_t>  m_videoFolders;
+    std::vector<TextRef>   m_fileNames;   // shares the name's bytes when they match
+    std::vector<TextRef>   m_names;
+    std::vector<uint32_t>  m_thumbnailFolders;
+    std::vector<TextRef>   m_thumbnailNames;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+class VideoLibrary;
+
+// Keeps the library in step with its folder using inotify instead of rescans.
+// A clip that finishes writing (IN_CLOSE_WRITE), is moved in (IN_MOVED_TO) or
+// disappears (IN_DELETE / IN_MOVED_FROM) is synced on its own through
+// LibraryLoader::SyncFile, and listeners are told which file changed.
+//
+// Events for the same file are merged over a short settle window, and a file
+// whose fingerprint still matches its row is skipped, so the writes the app
+// makes itself (metadata embedding) don't loop back into another sync.
+class LibraryWatcher {
+public:
+    using OnChanged = std::function<void(const std::filesystem::path& videoPath)>;
+
+    LibraryWatcher(std::filesystem::path folder, VideoLibrary* library);
+    ~LibraryWatcher();
+
+    LibraryWatcher(const LibraryWatcher&) = delete;
+    LibraryWatcher& operator=(const LibraryWatcher&) = delete;
+
+    // False if inotify is unavailable; callers fall back to rescans
+    bool Start();
+    void Stop();
+    bool IsRunning() const { return m_thread.joinable(); }
+
+    // Called on the watcher thread after a file was synced
+    void SetOnChanged(OnChanged cb);
+
+    // Video files the library tracks (skips hidden and ".temp." remux outputs)
+    static bool IsWatchedFile(const std::filesystem::path& path);
+
+private:
+    static constexpr int kSettleMs = 50;
+
+    void WatchLoop();
+    void ReadEvents(std::unordered_set<std::string>& pending, bool& overflowed) const;
+    void Flush(std::unordered_set<std::string>& pending, bool overflowed);
+    void Notify(const std::filesystem::path& videoPath);
+
+    std::filesystem::path m_folder;
+    VideoLibrary*         m_library;
+
+    int m_inotifyFd = -1;
+    int m_watchFd   = -1;
+    int m_wakeFd    = -1;   // eventfd used by Stop() to break out of poll()
+
+    std::mutex m_callbackMutex;
+    OnChanged  m_onChanged;
+
+    std::thread m_thread;
+};
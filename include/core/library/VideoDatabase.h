@@ -1,55 +1,166 @@
 #pragma once
 
 #include "core/VideoInfo.h"
+#include "core/library/LibrarySnapshot.h"
+#include "core/library/VideoQuery.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <span>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 struct sqlite3;
+struct sqlite3_stmt;
+class MediaProbe;
 
 class VideoDatabase {
 public:
     explicit VideoDatabase(const std::string& dbPath);
     ~VideoDatabase();
 
-    // Main function
-    VideoInfo *GetMetadata(const std::string &filePath);
+    // Main function. The record stays valid for as long as it is held, even if
+    // it is updated or deleted meanwhile; null if the path is unknown.
+    std::shared_ptr<const VideoInfo> GetMetadata(const std::string &filePath);
+
+    // The current version of every record; never null. Immutable, so it can be
+    // iterated while other threads write. The first call reads every row from
+    // SQLite (opening the database doesn't); after that it is a lock-free load.
+    std::shared_ptr<const LibrarySnapshot> GetSnapshot();
+
+    // Registers the file right away (name, size) and fills in duration,
+    // resolution and frame rate from a background scan
     void QueueForScanning(const std::string& filePath);
+
+    // Called from scanner threads after each file; total covers the current burst
+    using ScanProgress = std::function<void(size_t done, size_t total)>;
+    void SetScanProgressCallback(ScanProgress callback);
     void SaveMetadata(const VideoInfo& videoInfo);
-    std::vector<VideoInfo> GetAllVideos();
+    void SaveMetadataBatch(std::span<const VideoInfo> videos);
+
+    // Library-wide aggregates, kept current by triggers on every insert, update
+    // and delete; reading them is a single-row lookup
+    struct Totals {
+        size_t  videoCount           = 0;
+        double  durationSec          = 0.0;
+        int64_t sizeBytes            = 0;
+        size_t  withThumbnail        = 0;
+        size_t  withEmbeddedMetadata = 0;
+    };
+    Totals GetTotals();
+
+    // Totals, fingerprints and queries read through a second, read-only
+    // connection when one could be opened: WAL lets them run while a scan or
+    // sync is writing, and they see committed rows only.
 
+    // Stored file_path → fingerprint for every record, straight from SQLite
+    std::unordered_map<std::string, FileFingerprint> GetFingerprints();
 
-    // Search and Filters
+    // Writes between these share one transaction (and one fsync). Nestable;
+    // only the outermost CommitBatch commits. The batch belongs to the thread
+    // that opened it: other threads' writes wait for its commit instead of
+    // landing in it. Call both on the same thread.
+    void BeginBatch();
+    void CommitBatch();
+
+
+    // Search and Filters: one indexed statement per query, straight from
+    // SQLite; only the matching page is copied out
+    std::vector<VideoInfo> Query(const VideoQuery& query);
+    size_t Count(const VideoQuery& query);   // ignores sort and paging
     std::vector<VideoInfo> SearchByName(const std::string& query);
 
+    // Up to limit records, newest recording first, starting after the cursor
+    // (from the top without one). Only the columns the grid shows are read:
+    // path, name, size, duration, resolution, thumbnail, favourite, time.
+    std::vector<VideoInfo> GetGridPage(const std::optional<VideoPageCursor>& after, size_t limit);
+
     bool IsScanning() const;
     bool VideoExists(const std::string& filePath);
 
+    // Rebuilds the in-memory snapshot from SQLite
     void ClearCache();
     void DeleteMetadata(const std::string& filePath);
 
     size_t GetQueueSize() const;
 
+    // FFmpeg probe of the container and best video stream; no decoding
+    static VideoInfo ExtractVideoMetadata(const std::string& filePath);
+    static VideoInfo ExtractVideoMetadata(const MediaProbe& probe);
+
 private:
+    static constexpr size_t kScanBatchSize = 32;
+    static constexpr int kReadBusyTimeoutMs = 1000;
+
     // Database
     void InitializeDatabase() const;
+    void MigrateSchema() const;
+    void InitializeStats() const;
+    void InitializeSearch();
+    void PrepareStatements();
+    void OpenReadConnection(const std::string& dbPath);
+    void FinalizeStatements();
     void LoadCacheFromDB();
 
-    bool LoadFromDB(const std::string& filePath, VideoInfo& info) const;
-    void SaveToDB(const VideoInfo& info) const;
+    // Copy-on-write: a new snapshot with these records replaced or added and
+    // those paths removed, published in one atomic store
+    void Publish(std::span<const VideoInfo> upserts, std::span<const std::string> removals = {});
+    static void ReadRow(sqlite3_stmt* stmt, VideoInfo& info);
+    static void ReadGridRow(sqlite3_stmt* stmt, VideoInfo& info);
+    // On the read connection (the main one without it); caller holds ReadMutex()
+    sqlite3_stmt* PrepareCached(const std::string& sql);
+    std::mutex& ReadMutex() { return readDb ? readMutex : dbMutex; }
 
-    // Background
-    void BackgroundWorker() const;
+    bool LoadFromDB(const std::string& filePath, VideoInfo& info);
+    void SaveToDB(const VideoInfo& info);
 
-    static VideoInfo ExtractVideoMetadata(const std::string& filePath);
+    // Background
+    void BackgroundWorker();
+    void WriteScanResults(const std::vector<VideoInfo>& scanned);
 
     sqlite3* db;
-    std::unordered_map<std::string, VideoInfo> memoryCache;
-    std::mutex cacheMutex;
+
+    // Prepared once per connection; dbMutex serialises their use
+    std::mutex dbMutex;
+    sqlite3_stmt* insertStmt = nullptr;
+    sqlite3_stmt* selectStmt = nullptr;
+    sqlite3_stmt* deleteStmt = nullptr;
+    bool ftsAvailable = false;   // SQLite built without FTS5 falls back to LIKE
+
+    // Held from BeginBatch to CommitBatch by the batch's thread, and by every
+    // write; always taken before dbMutex
+    std::recursive_mutex batchMutex;
+    int  batchDepth = 0;          // owner's nesting
+    bool batchOpen  = false;      // BEGIN succeeded; otherwise writes autocommit
+
+    // Read-only, opened once at construction; readMutex serialises its statements
+    sqlite3* readDb = nullptr;
+    std::mutex readMutex;
+    std::unordered_map<std::string, sqlite3_stmt*> queryStmts;   // by SQL text; one per filter shape
+
+    // Holds only the records looked up so far until the first GetSnapshot()
+    std::atomic<std::shared_ptr<const LibrarySnapshot>> snapshot{std::make_shared<const LibrarySnapshot>()};
+    std::mutex publishMutex;   // serialises writers; readers never take it
+    std::once_flag fullLoad;
+
+    // Scanner pool; everything below is guarded by scanMutex
+    mutable std::mutex scanMutex;
+    std::condition_variable scanCv;
     std::queue<std::string> scanQueue;
-    std::thread workerThread;
+    std::unordered_set<std::string> queuedPaths;   // drops duplicate requests
+    std::vector<VideoInfo> pendingWrites;          // flushed in batches of kScanBatchSize
+    size_t activeScans = 0;
+    size_t scansDone = 0;
+    size_t scansQueued = 0;
+    ScanProgress scanProgress;
+    std::vector<std::thread> scanWorkers;
     bool running;
 };
\ No newline at end of file
@@ -1,12 +1,16 @@
 #pragma once
 
 #include "core/VideoInfo.h"
+#include "core/library/LibrarySnapshot.h"
+#include "core/library/VideoQuery.h"
 
 #include "core/CoreServices.h"
 
 #include <array>
 #include <filesystem>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -15,12 +19,16 @@
 // Forward declarations
 class VideoDatabase;
 class ThumbnailService;
+class ThumbnailAtlas;
 class MetadataEmbedder;
+class IntegrityChecker;
+class MediaProbe;
 class VideoScanner;
 
 class VideoLibrary {
 public:
-    explicit VideoLibrary(const ProjectPaths& paths);
+    // Shares the application's database; without one it opens its own on paths.dbPath
+    explicit VideoLibrary(const ProjectPaths& paths, std::shared_ptr<VideoDatabase> database = nullptr);
     ~VideoLibrary();
 
     VideoLibrary(const VideoLibrary&) = delete;
@@ -33,21 +41,40 @@ public:
 
 
     // Query Operations
-    std::vector<VideoInfo> GetAllVideos() const;
-    std::optional<std::reference_wrapper<const VideoInfo>> GetVideo(const std::string& filePath) const;
+    // Immutable; iterate it freely while the library keeps changing
+    std::shared_ptr<const LibrarySnapshot> GetSnapshot() const;
+    std::shared_ptr<const VideoInfo> GetVideo(const std::string& filePath) const;
+    std::vector<VideoInfo> Query(const VideoQuery& query) const;
+    size_t Count(const VideoQuery& query) const;
+    // Newest recording first, grid columns only; see VideoDatabase::GetGridPage
+    std::vector<VideoInfo> GetGridPage(const std::optional<VideoPageCursor>& after, size_t limit) const;
     std::vector<VideoInfo> SearchByName(const std::string& query) const;
     std::vector<VideoInfo> FilterByDuration(double minSec, double maxSec) const;
     std::vector<VideoInfo> FilterByResolution(int minWidth, int minHeight) const;
 
 
-    VideoInfo LoadVideo(const std::string& videoPath);
+    // generateThumbnail = false leaves it to a later RegenerateMissingThumbnails batch
+    VideoInfo LoadVideo(const std::string& videoPath, bool generateThumbnail = true);
     bool SaveVideo(const VideoInfo& info);
     bool UpdateVideo(const VideoInfo& info, bool updateVideoFile = false);
     bool DeleteVideo(const std::string& filePath, bool deleteFromDisk = false);
 
+    // Incremental sync: re-probe a file whose fingerprint changed (user fields are
+    // kept, the thumbnail is regenerated later), or forget one that is gone
+    VideoInfo RefreshVideo(const std::string& videoPath);
+    void RemoveMissingVideo(const std::string& videoPath);
+    void EnsureThumbnail(const std::string& videoPath);
+
     // Maintenance Operations
-    void RegenerateMissingThumbnails();
+    using ThumbnailProgress = std::function<void(size_t done, size_t total)>;
+    void RegenerateMissingThumbnails(const ThumbnailProgress& onProgress = nullptr);
+    void PackThumbnailAtlas() const;
+    // One clip's tile only: no snapshot, one stat and one page rebuilt
+    void PackThumbnail(const std::string& videoPath) const;
     void SyncWithVideoFiles() const;
+    // Drops records that are gone or fail the integrity check, deleting the
+    // file only when its container can't be opened at all; rows unchanged
+    // since they were probed with a duration are trusted
     void CleanupOrphanedRecords();
     static bool IsVideoCorrupted(const std::string &videoPath);
 
@@ -62,6 +89,10 @@ public:
 
     Statistics GetStatistics() const;
 
+    // Held by LibraryLoader for a whole folder or file sync, so the loader,
+    // the watcher and silent refreshes never diff or patch the same clip at once
+    std::mutex& SyncMutex() const { return m_syncMutex; }
+
     // Service Access
     VideoDatabase* GetDatabase() const { return m_database.get(); }
     ThumbnailService* GetThumbnailService() const { return m_thumbnailService.get(); }
@@ -71,14 +102,20 @@ private:
     // Helper methods
     static VideoInfo ScanVideoFile(const std::string& videoPath);
 
-    std::optional<std::string> GenerateThumbnail(const std::string &videoPath) const;
+    // probe: decode from an already open file instead of reopening it
+    std::optional<std::string> GenerateThumbnail(const std::string &videoPath,
+                                                 const MediaProbe* probe = nullptr) const;
 
     void EnsureDirectoriesExist() const;
 
     ProjectPaths m_paths;
 
     // Services
-    std::unique_ptr<VideoDatabase> m_database;
+    std::shared_ptr<VideoDatabase> m_database;
     std::unique_ptr<ThumbnailService> m_thumbnailService;
+    std::unique_ptr<ThumbnailAtlas> m_thumbnailAtlas;
     std::unique_ptr<MetadataEmbedder> m_metadataEmbedder;
+    std::unique_ptr<IntegrityChecker> m_integrityChecker;
+
+    mutable std::mutex m_syncMutex;
 };
\ No newline at end of file
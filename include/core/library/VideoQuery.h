@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+// A library query: every set field narrows the result, then it is sorted and
+// paged. VideoDatabase turns it into one indexed SQL statement, so only the
+// matching page is ever materialised.
+//
+//   VideoQuery q;
+//   q.text = "ranked";
+//   q.minDurationSec = 30;
+//   q.favoritesOnly = true;
+//   q.limit = 50;
+struct VideoQuery {
+    enum class SortKey {
+        RecordingTime,
+        Name,
+        Duration,
+        FileSize,
+        Resolution   // pixel count
+    };
+
+    // Substring of the file name, case-insensitive
+    std::string text;
+
+    std::optional<double>    minDurationSec;
+    std::optional<double>    maxDurationSec;
+    std::optional<int>       minWidth;
+    std::optional<int>       minHeight;
+    std::optional<long long> recordedAfterMs;    // inclusive
+    std::optional<long long> recordedBeforeMs;   // exclusive
+    bool                     favoritesOnly = false;
+
+    SortKey sortBy     = SortKey::RecordingTime;
+    bool    descending = true;
+
+    size_t limit  = 0;   // 0 = no limit
+    size_t offset = 0;
+};
+
+// Where a newest-first grid page ended: the next page starts strictly after
+// this row. Seeking by key instead of OFFSET keeps every page an index range,
+// however deep the user has scrolled.
+struct VideoPageCursor {
+    long long   recordingTimeMs = 0;
+    std::string filePath;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Rewrites a video's container-level tags without copying its media data.
+//
+// MP4/MOV: moov/udta/meta is rebuilt as an mdta keys + ilst list (the layout
+// FFmpeg writes with movflags=use_metadata_tags and reads back as plain tags).
+// The new moov goes where the old one was if it fits (the rest padded with a
+// free box) or if moov is the last box; otherwise it is appended and the old
+// one is renamed to free. Chunk offsets point into mdat, which never moves.
+//
+// Matroska/WebM: the global Tag inside Tags is replaced, in place when it fits
+// the old span (padded with Void) or Tags ends the file; otherwise Tags is
+// appended, the SeekHead entry and Segment size are updated and the old
+// element becomes Void.
+//
+// Only the header boxes are written. Layouts that can't be patched safely
+// (fragmented MP4 needing a moved moov, unknown-size clusters, no SeekHead...)
+// report NotPatchable so the caller can fall back to a remux.
+class ContainerPatcher {
+public:
+    using Tags = std::map<std::string, std::string>;
+
+    enum class Result {
+        Patched,
+        NotPatchable,   // nothing was written
+        Failed          // an I/O error after writing started
+    };
+
+    static Result WriteTags(const std::string& videoPath, const Tags& tags);
+
+private:
+    using Bytes = std::vector<uint8_t>;
+
+    static constexpr uint64_t kMaxHeaderBytes = 64ull * 1024 * 1024;   // moov / Tags / SeekHead
+
+    static Result PatchMp4(int fd, uint64_t fileSize, const Tags& tags);
+    static Result PatchMatroska(int fd, uint64_t fileSize, const Tags& tags);
+
+    static Bytes BuildMdtaMeta(const Tags& tags);
+    static Bytes BuildMatroskaTag(const Tags& tags);
+};
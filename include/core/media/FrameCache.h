@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+// LRU of recently decoded frames keyed by presentation time, bounded by bytes.
+// Frames are held by reference, so a cache hit costs no decode and no copy.
+class FrameCache {
+public:
+    explicit FrameCache(size_t maxBytes) : m_maxBytes(maxBytes) {}
+    ~FrameCache();
+
+    FrameCache(const FrameCache&) = delete;
+    FrameCache& operator=(const FrameCache&) = delete;
+
+    void Insert(double seconds, const AVFrame* frame);
+
+    // New reference to the frame on screen at `seconds` (caller frees), or nullptr
+    AVFrame* Find(double seconds, double frameDuration);
+
+    void Clear();
+
+private:
+    struct Entry {
+        AVFrame*                    frame = nullptr;
+        size_t                      bytes = 0;
+        std::list<double>::iterator lruPos;
+    };
+
+    void EvictLocked();
+
+    std::mutex              m_mutex;
+    std::map<double, Entry> m_entries;   // ordered by time for lookups
+    std::list<double>       m_lru;       // front = most recently used
+    size_t                  m_bytes    = 0;
+    size_t                  m_maxBytes = 0;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "core/Config.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/hwcontext.h>
+}
+
+// Optional VAAPI decode shared by everything that opens a video decoder.
+// A single device is created lazily and shared; if it can't be created, or the
+// codec/profile has no VAAPI path, decoders stay on software. In Auto that is
+// quiet; VAAPI was asked for explicitly, so each fallback is reported loudly.
+class HwDecoder {
+public:
+    // Set once from Config at startup
+    static void Configure(HwDecodeMode mode, const std::string& devicePath);
+
+    // Call between avcodec_parameters_to_context and avcodec_open2.
+    // Returns true if the context will decode on the GPU.
+    static bool Attach(AVCodecContext* codecCtx, const AVCodec* codec);
+
+    // GPU surfaces are downloaded into swFrame (NV12/P010); software frames pass through
+    static const AVFrame* Download(const AVFrame* frame, AVFrame* swFrame);
+
+    static void Shutdown();
+
+private:
+    static AVBufferRef* AcquireDevice();
+    static AVPixelFormat GetFormat(AVCodecContext* codecCtx, const AVPixelFormat* formats);
+    static void WarnForcedFallback(const std::string& codecName, const char* reason);
+
+    static std::mutex   s_mutex;
+    static HwDecodeMode s_mode;
+    static std::string  s_devicePath;
+    static AVBufferRef* s_device;
+    static bool         s_deviceFailed;
+    static std::unordered_set<std::string> s_warnedCodecs;   // forced-VAAPI fallbacks already reported
+};
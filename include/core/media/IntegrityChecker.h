@@ -0,0 +1,69 @@
+#pragma once
+
+#include "core/FileFingerprint.h"
+#include "core/ThreadPool.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Tells whether a video is playable without leaving the process. The quick
+// check opens the container header (a missing moov fails here), requires a
+// duration (estimated by a bounded stream probe when the header has none),
+// then seeks to the last seconds and reads the packets there, which
+// catches recordings cut short. The deep check decodes every video packet.
+//
+// Verdicts are cached per path and stay valid while the file's fingerprint
+// does, so checking an unchanged library again costs a stat per file.
+class IntegrityChecker {
+public:
+    enum class Verdict {
+        Ok,
+        Missing,       // not on disk; not corruption
+        Unreadable,    // header could not be parsed (e.g. no moov atom)
+        NoDuration,
+        Truncated,     // the tail is missing or cut mid-packet
+        Undecodable    // deep check only
+    };
+
+    static constexpr int64_t kTailWindowUs     = 2'000'000;
+    static constexpr int     kMaxTailPackets   = 4096;
+    static constexpr int     kMaxErrorsPercent = 1;   // deep check: tolerated decode errors
+
+    explicit IntegrityChecker(size_t threadCount = 0);   // 0 = a quarter of the cores
+    ~IntegrityChecker() = default;
+
+    IntegrityChecker(const IntegrityChecker&) = delete;
+    IntegrityChecker& operator=(const IntegrityChecker&) = delete;
+
+    // Uncached
+    static Verdict Inspect(const std::string& videoPath, bool deepDecode = false);
+
+    Verdict Check(const std::string& videoPath, bool deepDecode = false);
+
+    // Checks on the pool; verdicts in input order
+    std::vector<Verdict> CheckAll(const std::vector<std::string>& videoPaths, bool deepDecode = false);
+
+    void ClearCache();
+
+    static bool IsCorrupted(const Verdict verdict) {
+        return verdict != Verdict::Ok && verdict != Verdict::Missing;
+    }
+    // Only a container that can't be opened at all is certain enough to
+    // delete; the other failures are heuristics a playable file can trip
+    static bool IsUnrecoverable(const Verdict verdict) { return verdict == Verdict::Unreadable; }
+    static const char* ToString(Verdict verdict);
+
+private:
+    struct CacheEntry {
+        FileFingerprint fingerprint;
+        bool            deep = false;
+        Verdict         verdict = Verdict::Ok;
+    };
+
+    std::unordered_map<std::string, CacheEntry> m_cache;
+    std::mutex                                  m_cacheMutex;
+    std::unique_ptr<ThreadPool>                 m_pool;   // last: joined before the cache goes
+};
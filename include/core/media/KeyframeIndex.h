@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Sorted presentation times of every keyframe in a file's video stream.
+// Built once with a packet-only scan (no decoding) and persisted next to the
+// library so later opens can seek straight to the right GOP.
+class KeyframeIndex {
+public:
+    // Loads indexPath if it still matches the video, otherwise scans and saves.
+    // An empty indexPath keeps the index in memory only.
+    bool LoadOrBuild(const std::string& videoPath,
+                     const std::filesystem::path& indexPath,
+                     const std::atomic<bool>& cancel);
+
+    bool IsEmpty() const { return m_keyframes.empty(); }
+    size_t GetCount() const { return m_keyframes.size(); }
+
+    // Time (seconds) of the last keyframe at or before `seconds`, or -1 if none
+    double KeyframeAtOrBefore(double seconds) const;
+
+private:
+    bool Build(const std::string& videoPath, const std::atomic<bool>& cancel);
+    bool Load(const std::filesystem::path& indexPath);
+    bool Save(const std::filesystem::path& indexPath) const;
+
+    static bool ReadFileStamp(const std::string& videoPath, uint64_t& size, int64_t& mtime);
+
+    std::vector<double> m_keyframes;
+    uint64_t            m_fileSize  = 0;
+    int64_t             m_fileMtime = 0;
+};
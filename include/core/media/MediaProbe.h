@@ -0,0 +1,60 @@
+#pragma once
+
+#include "core/VideoInfo.h"
+
+#include <map>
+#include <string>
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+// Opens a video once and answers every import-time question from that open:
+// container tags, the best video stream, duration and frame rate. Probing is
+// bounded (probesize / analyzeduration) because a recording's first seconds
+// describe its streams as well as the whole file does. ThumbnailService can
+// decode straight from the same context, so importing a clip opens it once.
+class MediaProbe {
+public:
+    static constexpr int64_t kProbeSizeBytes    = 5ll * 1024 * 1024;
+    static constexpr int64_t kAnalyzeDurationUs = 3'000'000;
+
+    // findStreams = false only reads the header (tags), skipping stream analysis
+    explicit MediaProbe(const std::string& path, bool findStreams = true);
+    ~MediaProbe();
+
+    MediaProbe(const MediaProbe&) = delete;
+    MediaProbe& operator=(const MediaProbe&) = delete;
+
+    bool IsOpen() const { return m_formatCtx != nullptr; }
+
+    // The bounded stream analysis a header-only open skipped; also estimates
+    // the duration of containers that don't store one (FLV, MPEG-TS, live
+    // WebM). Runs once; false if the file is closed or analysis failed.
+    bool FindStreams();
+    bool HasVideo() const { return m_videoStream >= 0; }
+
+    // Releases the file early, e.g. before the embedder rewrites it
+    void Close();
+
+    const std::string& GetPath() const { return m_path; }
+
+    // Container tags; keys are lower-cased since containers disagree on case
+    const std::map<std::string, std::string>& GetTags() const { return m_tags; }
+    bool HasTag(const std::string& key) const { return m_tags.contains(key); }
+
+    // Path, name, size, mtime and fingerprint always; duration, resolution and
+    // frame rate when the file opened with a video stream
+    void FillVideoInfo(VideoInfo& info) const;
+
+    // For decoding from this open (thumbnails)
+    AVFormatContext* GetFormatContext() const { return m_formatCtx; }
+    int GetVideoStreamIndex() const { return m_videoStream; }
+
+private:
+    std::string                        m_path;
+    AVFormatContext*                   m_formatCtx   = nullptr;
+    int                                m_videoStream = -1;
+    bool                               m_streamsFound = false;
+    std::map<std::string, std::string> m_tags;
+};
@@ -6,18 +6,29 @@
 #include <string>
 #include <map>
 
+class MediaProbe;
+
 class MetadataEmbedder{
 public:
+    // Written as app_version when the video doesn't carry one yet
+    static constexpr const char* DEFAULT_APP_VERSION = "0.0.1";
+
     static bool WriteMetadataToVideo(const std::string& videoPath, const VideoInfo& info);
     static bool ReadMetadataFromVideo(const std::string& videoPath, VideoInfo& info);
+    static bool ReadMetadataFromVideo(const MediaProbe& probe, VideoInfo& info);
 
     static bool HasEmbeddedMetadata(const std::string& videoPath);
+    static bool HasEmbeddedMetadata(const MediaProbe& probe);
 
     static bool AddCustomTag(const std::string& videoPath,
                              const std::string& key,
                              const std::string& value);
     
 private:
+    // In-place header patch (ContainerPatcher), full remux as the fallback
+    static bool WriteTags(const std::string& videoPath,
+                          const std::map<std::string, std::string>& tags);
+
     static std::map<std::string, std::string> VideoInfoToTags(const VideoInfo& info);
     static void TagsToVideoInfo(const std::map<std::string, std::string>& tags, VideoInfo& info);
 
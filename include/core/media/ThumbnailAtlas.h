@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Sprite-sheet copy of the per-video thumbnails in .moment/thumbnails.
+// Tiles are packed 8x8 into JPEG pages (atlas_<n>.jpg, 2560x1440) and located
+// through a small text index (atlas.idx), so the grid loads with a handful of
+// file reads and texture uploads instead of one per clip.
+//
+// The individual thumbnail JPEGs stay the source of truth: Sync() repacks only
+// pages whose tiles were added or changed, rebuilding them from those files so
+// JPEG re-encoding never compounds.
+//
+// One instance may be shared between threads: every call holds its lock, so
+// a sync never races another over the tiles or the page and index files.
+class ThumbnailAtlas {
+public:
+    static constexpr int kTileWidth    = 320;
+    static constexpr int kTileHeight   = 180;
+    static constexpr int kColumns      = 8;
+    static constexpr int kRows         = 8;
+    static constexpr int kTilesPerPage = kColumns * kRows;
+    static constexpr int kPageWidth    = kTileWidth * kColumns;
+    static constexpr int kPageHeight   = kTileHeight * kRows;
+
+    struct Tile {
+        int     page        = -1;
+        int     slot        = -1;
+        int64_t sourceMtime = 0;   // thumbnail file's mtime when it was packed
+    };
+
+    // Normalised texture coordinates of a tile within its page
+    struct UvRect {
+        float u0 = 0.0f, v0 = 0.0f;
+        float u1 = 1.0f, v1 = 1.0f;
+    };
+
+    explicit ThumbnailAtlas(std::filesystem::path folder);
+
+    ThumbnailAtlas(const ThumbnailAtlas&) = delete;
+    ThumbnailAtlas& operator=(const ThumbnailAtlas&) = delete;
+
+    // Reads the index; false (and empty) if it is missing or unreadable
+    bool Load();
+
+    // Packs the given thumbnail files, drops tiles no longer listed and
+    // rewrites the pages and index that changed
+    bool Sync(const std::vector<std::string>& thumbnailPaths);
+
+    // Places or refreshes one thumbnail's tile and rebuilds only its page;
+    // the index gains one line. Tiles of deleted thumbnails wait for Sync.
+    bool Update(const std::string& thumbnailPath);
+
+    // Tile for a thumbnail file, or nullopt if it isn't packed or (when
+    // checkSource) the file was rewritten after it was packed
+    std::optional<Tile> Find(const std::string& thumbnailPath, bool checkSource = true) const;
+
+    std::filesystem::path GetPagePath(int page) const;
+    static UvRect GetTileUv(int slot);
+
+private:
+    // Callers hold m_mutex
+    bool LoadIndex();
+    bool SaveIndex();
+    bool AppendIndex(const std::string& key, const Tile& tile) const;
+    bool RebuildPage(int page, const std::unordered_map<std::string, std::string>& sources) const;
+
+    static std::string TileKey(const std::string& thumbnailPath);
+    static int64_t ReadMtime(const std::string& path);
+
+    mutable std::mutex                    m_mutex;
+    std::filesystem::path                 m_folder;
+    std::unordered_map<std::string, Tile> m_tiles;   // keyed by thumbnail file name
+    int                                   m_pageCount = 0;
+    bool                                  m_indexLoaded = false;   // m_tiles matches atlas.idx
+};
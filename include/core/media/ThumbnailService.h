@@ -1,7 +1,13 @@
 #pragma once
 
-#include <string>
+#include "core/ThreadPool.h"
+
+#include <atomic>
 #include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
 
 extern "C" {
 #include <libavformat/avformat.h>
@@ -12,18 +18,27 @@ extern "C" {
 
 namespace fs = std::filesystem;
 
+class MediaProbe;
+
 enum class ThumbnailStrategy {
     FIRST_FRAME,
     FRAME_AT_1SEC,
     FRAME_AT_10SEC,
     MIDDLE_FRAME,
     RANDOM_FRAME,
-    SMART_FRAME
+    SMART_FRAME,
+    KEYFRAME_NEAR_1SEC   // keyframe at or before 1s, one decode; timing is approximate
+};
+
+struct ThumbnailJob {
+    std::string              videoPath;
+    std::future<std::string> thumbnailPath;   // empty on failure or cancellation
 };
 
 class ThumbnailService {
 public:
     explicit ThumbnailService(const std::string& thumbFolder);
+    ~ThumbnailService();
 
     std::string GenerateThumbnail(
         const std::string& videoPath,
@@ -32,10 +47,46 @@ public:
         int thumbnailHeight = 180
     ) const;
 
+    // Same, decoding from an already open probe instead of reopening the file
+    std::string GenerateThumbnail(
+        const MediaProbe& probe,
+        ThumbnailStrategy strategy = ThumbnailStrategy::FRAME_AT_1SEC,
+        int thumbnailWidth = 320,
+        int thumbnailHeight = 180
+    ) const;
+
+    // Queue thumbnails on the worker pool; one future per video, in input order
+    std::vector<ThumbnailJob> SubmitBatch(
+        const std::vector<std::string>& videoPaths,
+        ThumbnailStrategy strategy = ThumbnailStrategy::FRAME_AT_1SEC,
+        int thumbnailWidth = 320,
+        int thumbnailHeight = 180
+    );
+
+    // Jobs that haven't started yet resolve to "" instead of running
+    void CancelPending();
+
 private:
     std::string thumbnailFolder;
     std::string GetThumbnailPath(const std::string &videoPath) const;
 
+    std::string GenerateThumbnailInternal(
+        const std::string& videoPath,
+        ThumbnailStrategy strategy,
+        int thumbnailWidth,
+        int thumbnailHeight,
+        int codecThreads
+    ) const;
+
+    static bool ExtractThumbnail(
+        const MediaProbe& probe,
+        const std::string& thumbnailPath,
+        ThumbnailStrategy strategy,
+        int thumbnailWidth,
+        int thumbnailHeight,
+        int codecThreads
+    );
+
     static bool ExtractFrame(
         AVFormatContext* formatCtx,
         AVCodecContext* codecCtx,
@@ -43,7 +94,8 @@ private:
         int64_t targetPts,
         const std::string& outputPath,
         int thumbnailWidth,
-        int thumbnailHeight
+        int thumbnailHeight,
+        bool keyframeOnly
     );
 
     static int64_t CalculateTargetPts(
@@ -56,7 +108,8 @@ private:
         AVFormatContext* formatCtx,
         AVCodecContext* codecCtx,
         int videoStreamIndex,
-        int64_t targetPts
+        int64_t targetPts,
+        bool keyframeOnly
     );
 
     static bool SaveFrameAsJPEG(
@@ -66,4 +119,9 @@ private:
         int height
     );
 
+    // Worker pool: jobs × codec threads ≈ cores, so a batch doesn't oversubscribe
+    size_t workerCount = 1;
+    int codecThreadsPerJob = 1;
+    std::atomic<uint64_t> batchGeneration{0};
+    std::unique_ptr<ThreadPool> workerPool;   // last: joined before the rest is destroyed
 };
\ No newline at end of file
@@ -1,8 +1,17 @@
 #pragma once
 
 #include "core/VideoInfo.h"
-
+#include "core/media/FrameCache.h"
+#include "core/media/KeyframeIndex.h"
+#include "core/media/YuvRenderer.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
 
 extern "C" {
 #include <libavformat/avformat.h>
@@ -13,6 +22,18 @@ extern "C" {
 
 #include <imgui.h>
 
+// Playback runs as a three-stage pipeline:
+//   demux thread  → bounded packet queue →
+//   decode thread → fixed ring of decoded YUV frames keyed by PTS →
+//   render thread (Update) picks the frame for the current clock and hands its
+//   planes to YuvRenderer, which converts to RGB on the GPU.
+// Seeks bump a serial number; anything tagged with an older serial is dropped.
+//
+// Scrubbing: every decoded frame also lands in an LRU (FrameCache), so seeking
+// near the playhead is served without touching the decoder. Misses seek to the
+// exact keyframe from a persisted KeyframeIndex and decode forward to the
+// requested time; drags inside the GOP already being decoded just move the
+// target instead of restarting it.
 class VideoPlayer {
 public:
     VideoPlayer() = default;
@@ -35,36 +56,84 @@ public:
 
     // Render frame to ImGui texture
     void Update(float deltaTime);
-    ImTextureID GetFrameTexture() const { return static_cast<ImTextureID>(static_cast<intptr_t>(m_textureId)); }
+    ImTextureID GetFrameTexture() const { return static_cast<ImTextureID>(static_cast<intptr_t>(m_renderer.GetTexture())); }
 
     // Video info
     int GetWidth() const { return m_width; }
     int GetHeight() const { return m_height; }
 
 private:
+    static constexpr size_t kMaxQueuedPackets = 96;
+    static constexpr size_t kFrameRingSize    = 4;
+    static constexpr size_t kFrameCacheBytes  = 256ull * 1024 * 1024;
+
+    // Demuxed packet; packet == nullptr marks end of stream
+    struct QueuedPacket {
+        AVPacket* packet = nullptr;
+        uint64_t  serial = 0;
+    };
+
+    // Decoded frame ready for upload (a reference to the decoder's buffer,
+    // or a CPU-converted copy for formats the shader cannot sample)
+    struct DecodedFrame {
+        double   pts   = 0.0;
+        AVFrame* frame = nullptr;
+    };
+
     // FFmpeg context
-    AVFormatContext* m_formatCtx = nullptr;
-    AVCodecContext* m_codecCtx = nullptr;
+    AVFormatContext* m_formatCtx = nullptr;   // owned by the demux thread once started
+    AVCodecContext* m_codecCtx = nullptr;     // owned by the decode thread once started
     AVStream* m_videoStream = nullptr;
     int m_videoStreamIndex = -1;
 
-    // Frame processing
+    // Frame processing (decode thread)
     AVFrame* m_frame = nullptr;
-    AVFrame* m_rgbFrame = nullptr;
-    SwsContext* m_swsCtx = nullptr;
-    uint8_t* m_buffer = nullptr;
-
-    // OpenGL texture
-    unsigned int m_textureId = 0;
-
-    // Playback state
+    AVFrame* m_swFrame = nullptr;     // download target for VAAPI surfaces
+    SwsContext* m_swsCtx = nullptr;   // only for pixel formats YuvRenderer can't take
+
+    // GPU colour conversion
+    YuvRenderer m_renderer;
+
+    // Scrubbing support
+    FrameCache          m_frameCache{kFrameCacheBytes};
+    KeyframeIndex       m_keyframeIndex;          // written by m_indexThread until m_indexReady
+    std::thread         m_indexThread;
+    std::atomic<bool>   m_indexReady{false};
+    std::atomic<double> m_decodeTarget{0.0};      // frames before this are cached, not shown
+    std::atomic<double> m_lastDecodedPts{-1.0};
+
+    // Pipeline threads
+    std::thread       m_demuxThread;
+    std::thread       m_decodeThread;
+    std::atomic<bool> m_quit{false};
+
+    // Packet queue (demux → decode), also carries seek requests
+    std::mutex               m_packetMutex;
+    std::condition_variable  m_packetCv;
+    std::deque<QueuedPacket> m_packets;
+    uint64_t                 m_serial      = 0;
+    bool                     m_seekPending = false;
+    double                   m_seekTarget  = 0.0;   // keyframe time when the index knows it
+    bool                     m_demuxEof    = false;
+
+    // Frame ring (decode → render)
+    std::mutex                                m_frameMutex;
+    std::condition_variable                   m_frameCv;
+    std::array<DecodedFrame, kFrameRingSize>  m_frames;
+    size_t                                    m_frameRead  = 0;
+    size_t                                    m_frameCount = 0;
+    std::atomic<uint64_t>                     m_frameSerial{0};
+
+    // Playback state (render thread)
     bool m_isPlaying = false;
     bool m_isLoaded = false;
+    bool m_awaitingSeekFrame = false;
+    bool m_pipelineStale = false;      // a cached frame is shown; pipeline is elsewhere
+    double m_seekKeyframe = -1.0;      // keyframe the pipeline last restarted from
     double m_currentTime = 0.0;
     double m_duration = 0.0;
     double m_frameRate = 30.0;
     double m_frameTime = 1.0 / 30.0;
-    double m_frameAccumulator = 0.0;
 
     // Video properties
     int m_width = 0;
@@ -72,7 +141,11 @@ private:
 
     // Helper methods
     void Cleanup();
-    void CreateTexture();
-    void UpdateFrame();
-    void DecodeFrame();
-};
\ No newline at end of file
+    void StartPipeline();
+    void StopPipeline();
+    void RequestPipelineSeek(double seconds);
+    void DemuxLoop();
+    void DecodeLoop();
+    bool PushDecodedFrame(const AVFrame* frame, uint64_t serial);
+    void PopFrame();
+};
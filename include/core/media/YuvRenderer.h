@@ -0,0 +1,66 @@
+#pragma once
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+// Converts decoded YUV frames to RGBA on the GPU.
+// Planes are uploaded as single/dual channel textures and a small shader draws
+// them into an FBO whose colour texture can be handed to ImGui::Image.
+// All methods must be called on the thread that owns the GL context.
+class YuvRenderer {
+public:
+    YuvRenderer() = default;
+    ~YuvRenderer();
+
+    YuvRenderer(const YuvRenderer&) = delete;
+    YuvRenderer& operator=(const YuvRenderer&) = delete;
+
+    bool Init(int width, int height);
+    void Release();
+
+    // Pixel formats that can be uploaded as-is (everything else needs a CPU convert first)
+    static bool IsSupported(int pixelFormat);
+
+    // Upload the planes of a frame and redraw the output texture
+    void Render(const AVFrame* frame);
+
+    unsigned int GetTexture() const { return m_outputTexture; }
+
+private:
+    enum class PlaneLayout { Planar, SemiPlanar };
+
+    struct FormatInfo {
+        PlaneLayout layout     = PlaneLayout::Planar;
+        bool        is16Bit    = false;
+        float       valueScale = 1.0f;   // 10-bit LSB-aligned samples need widening
+        bool        fullRange  = false;
+    };
+
+    static FormatInfo DescribeFormat(int pixelFormat);
+
+    bool CompileProgram();
+    void EnsurePlaneTextures(const AVFrame* frame, const FormatInfo& info);
+    void UploadPlane(unsigned int texture, const uint8_t* data, int linesize,
+                     int width, int height, int channels, bool is16Bit) const;
+    void SetColorUniforms(const AVFrame* frame, const FormatInfo& info) const;
+
+    int m_width  = 0;
+    int m_height = 0;
+
+    unsigned int m_program       = 0;
+    unsigned int m_vao           = 0;
+    unsigned int m_fbo           = 0;
+    unsigned int m_outputTexture = 0;
+    unsigned int m_planeTextures[3] = {0, 0, 0};
+
+    // Plane textures are (re)allocated when the frame layout changes
+    int m_planeFormat = -1;
+    int m_planeWidth  = 0;
+    int m_planeHeight = 0;
+
+    int m_locLayout = -1;
+    int m_locScale  = -1;
+    int m_locMatrix = -1;
+    int m_locOffset = -1;
+};
@@ -1,8 +1,13 @@
 #pragma once
 
+#include "core/EventQueue.h"
 #include "core/recording/NativeRecorder.h"
 
 #include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 // ──────────────────────────────────────────────────────────────────────────
 enum class RecordingMode { NATIVE, OBS };
@@ -14,7 +19,15 @@ public:
     ~RecordingManager();
 
     void Initialize();
-    void SetOnClipSaved(std::function<void(const fs::path&)> cb);
+
+    // Status lines posted from the recorder's threads, drained by the UI once
+    // per frame (one consumer). Lossy: only the latest line is ever shown.
+    template<typename Handler>
+    size_t DrainStatus(Handler&& handler) { return m_statusLines.Drain(std::forward<Handler>(handler)); }
+
+    // Clips saved since the last call, oldest first. Unlike status lines these
+    // are never dropped, however long the UI goes without asking.
+    std::vector<fs::path> TakeSavedClips();
 
     // ── Recording ───────────────────────────────────────────────────────────
     void StartRecording();
@@ -30,10 +43,14 @@ public:
     // GetOBSRecorder
     NativeRecorder* GetNativeRecorder() const { return m_nativeRecorder.get(); }
 
-    void ApplyConfig() const;
+    void ApplyConfig();
 
 private:
+    static constexpr size_t kStatusCapacity = 64;
+
     std::unique_ptr<NativeRecorder> m_nativeRecorder;
-    std::function<void(const fs::path&)> m_onClipSaved;
+    EventQueue<std::string> m_statusLines{kStatusCapacity};
+    std::mutex m_savedClipsMutex;
+    std::vector<fs::path> m_savedClips;
     int m_clipDuration;
 };
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "core/EventQueue.h"
 #include "core/media/VideoExporter.h"
 
+#include <deque>
 #include <memory>
+#include <string>
 
 
 class EditingScreen;
@@ -28,11 +31,15 @@ private:
     static std::string GenerateDefaultFilename(const std::string& inputFilename);
     void AddLog(const std::string& message);
 
+    static constexpr size_t kMaxLogs = 100;
+
     std::unique_ptr<VideoExporter> m_exporter;
     char m_outputFilename[256];
     ExportQuality m_selectedQuality = ExportQuality::ORIGINAL;
 
-    std::vector<std::string> m_exportLogs;
+    // The exporter's thread posts log lines; Draw moves them into m_exportLogs
+    EventQueue<std::string> m_pendingLogs{256};
+    std::deque<std::string> m_exportLogs;
     float m_lastProgress = 0.0f;
     bool m_initialized = false;
 };
\ No newline at end of file
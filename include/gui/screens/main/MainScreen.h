@@ -6,9 +6,13 @@
 #include "gui/screens/main/states/VideoListState.h"
 #include "gui/screens/main/states/EmptyFolderState.h"
 #include "gui/widgets/FolderBrowser.h"
+#include "core/library/LibraryTable.h"
 #include "core/library/VideoLibrary.h"
 
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <optional>
 #include <string>
 #include <vector>
 #include <filesystem>
@@ -21,6 +25,13 @@ struct StorageInfo {
     float  freeSpaceGB  = 0.0f;
 };
 
+// Grid labels, formatted once per library refresh rather than every frame
+struct VideoDisplayText {
+    std::string date;
+    std::string duration;
+    std::string resolution;
+};
+
 enum class MainScreenState {
     WELCOME,
     LOADING,
@@ -32,12 +43,22 @@ enum class MainScreenState {
 class MainScreen : public BaseScreen {
 public:
     explicit MainScreen(MainWindow* manager);
+    ~MainScreen() override;
 
     void Draw() override;
 
     // ── Public API ────────────────────────────────────────────────────────────
-    std::vector<VideoInfo>& GetCurrentVideos() { return m_currentVideos; }
-    void SetCurrentVideos(const std::vector<VideoInfo>& videos) { m_currentVideos = videos; }
+    // The library on screen, row i being the grid's i-th tile (newest first).
+    // Only the pages scrolled to so far are loaded: GetLibrarySize() counts
+    // every clip, the table holds the newest Size() of them.
+    const LibraryTable& GetLibraryTable() const { return m_libraryTable; }
+    const std::vector<VideoDisplayText>& GetVideoDisplayText() const { return m_videoDisplayText; }
+    size_t GetLibrarySize() const;
+
+    // Pulls pages until the first rowCount display rows are loaded or the library runs out
+    void EnsureRowsLoaded(size_t rowCount);
+    // Drops the loaded pages and reads the first one again
+    void ResetLibraryView();
 
     FolderBrowser& GetFolderBrowser() { return m_folderBrowser; }
     std::filesystem::path GetCurrentFolder() const;
@@ -53,16 +74,37 @@ private:
     std::unique_ptr<VideoListState>   m_videoListState;
     std::unique_ptr<EmptyFolderState> m_emptyFolderState;
 
-    std::vector<VideoInfo> m_currentVideos;
+    LibraryTable                     m_libraryTable;       // newest recording first
+    std::vector<VideoDisplayText>    m_videoDisplayText;   // by LibraryTable::RowId
+    std::optional<VideoPageCursor>   m_pageCursor;         // after the last loaded row
+    size_t                           m_librarySize = 0;
+    bool                             m_allPagesLoaded = false;
     FolderBrowser          m_folderBrowser;
 
     // ── Callbacks ─────────────────────────────────────────────────────────────
     std::function<void()> m_onSettingsClicked;
 
+    // ── Events ────────────────────────────────────────────────────────────────
+    // Loader, watcher and refresh threads raise these instead of touching the
+    // screen; Draw() takes them once per frame, so state only changes on the
+    // UI thread. Flags rather than a queue: they can't be dropped, and any
+    // number of changes coalesce into one reload.
+    std::atomic<bool> m_libraryLoaded{false};    // the initial load finished
+    std::atomic<bool> m_libraryChanged{false};   // files were synced since
+    bool m_syncSavedClips = false;   // no watcher: saved clips are synced here
+    std::string m_recordingStatus;   // last status line from the recorder
+
+    void DrainEvents();
+
     // ── Library helpers ───────────────────────────────────────────────────────
     bool ValidateLibraryPath();
     void StartLibraryLoad();
-    void RefreshLibrarySilent();
+    void RefreshLibrarySilent(const std::filesystem::path& changedFile = {});
+    void ReloadVideoList();   // re-reads the library without syncing the folder
+    bool LoadNextPage();
+
+    // One screenful or so; a page is a single index range scan
+    static constexpr size_t kGridPageSize = 256;
     void ChangeState(MainScreenState state) { m_currentState = state; }
     const char* GetCurrentWindowName() const;
 
@@ -72,4 +114,14 @@ private:
     void DrawClipSaveButton();
     void DrawStorageInfo(const StorageInfo& info);
     static StorageInfo CalculateStorageInfo(const std::string& libraryPath, size_t videoCount);
+
+    // ── Storage sampler ───────────────────────────────────────────────────────
+    // statvfs runs every few seconds (or right after the library changed),
+    // not once per frame
+    static constexpr std::chrono::seconds kStorageSampleInterval{5};
+    const StorageInfo& SampleStorageInfo(const std::string& libraryPath);
+
+    StorageInfo                           m_storageInfo;
+    std::chrono::steady_clock::time_point m_storageSampledAt;
+    bool                                  m_storageStale = true;
 };
\ No newline at end of file
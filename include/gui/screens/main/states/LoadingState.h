@@ -1,8 +1,9 @@
 #pragma once
-#include <vector>
+#include "core/EventQueue.h"
+
 #include <chrono>
+#include <deque>
 #include <string>
-#include <mutex>
 
 class MainScreen;
 
@@ -17,13 +18,16 @@ public:
     LoadingState() = default;
     
     void Draw(MainScreen* parent);
+    // Any thread; the entry shows up (and moves the bar) on the next frame
     void AddLog(const std::string& message, float progress);
-    void SetProgress(const float progress) { m_progress = progress; }
     float GetProgress() const { return m_progress; }
-    void Clear();
+    void Clear();   // UI thread
     
 private:
-    std::vector<LoadingLog> m_logs;
+    static constexpr size_t kMaxLogs = 100;
+
+    // Posted by the loader, drained by Draw; the rest is render-thread only
+    EventQueue<LoadingLog> m_pendingLogs{256};
+    std::deque<LoadingLog> m_logs;
     float m_progress = 0.0f;
-    std::mutex m_logMutex;
 };
\ No newline at end of file
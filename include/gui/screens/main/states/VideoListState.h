@@ -1,8 +1,14 @@
 #pragma once
 
 #include "gui/core/MainWindow.h"
+#include "gui/utils/ThumbnailLoader.h"
+#include "gui/utils/ThumbnailStreamer.h"
+#include "core/library/LibraryTable.h"
+
+#include <vector>
 
 class MainScreen;
+struct VideoDisplayText;
 
 class VideoListState {
 public:
@@ -10,13 +16,21 @@ public:
     
     void Draw(MainScreen* parent);
 
-    static void LoadThumbnails(MainScreen* parent);
     void RequestThumbnailReload() { m_thumbnailsLoaded = false; }
     
 private:
     bool m_thumbnailsLoaded = false;
 
-    static void DrawVideoGrid(MainScreen* parent);
+    // Thumbnails stream in for what's on screen; sources are resolved as pages load
+    ThumbnailStreamer            m_thumbnailStreamer;
+    std::vector<ThumbnailSource> m_thumbnailSources;   // by LibraryTable::RowId
+    ThumbnailAtlasCache          m_atlases;            // read once per library reload
+
+    void LoadThumbnails(MainScreen* parent);
+    void ResolveNewThumbnails(const MainScreen* parent);
+    void DrawVideoGrid(MainScreen* parent);
+    void DrawVideoTile(MainScreen* parent, const LibraryTable& table, LibraryTable::RowId row,
+                       const VideoDisplayText* label, float thumbnailSize, float tHeight);
 
     static MainWindow* GetMainWindow(const MainScreen* parent);
 };
\ No newline at end of file
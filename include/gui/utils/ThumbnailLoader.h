@@ -1,17 +1,37 @@
 #pragma once
 
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
 #include <vector>
 
 #include "imgui.h"
+#include "core/media/ThumbnailAtlas.h"
 
-struct VideoInfo;
+class LibraryTable;
+
+// Loaded atlas indexes by thumbnail folder (in practice just the library's)
+using ThumbnailAtlasCache = std::map<std::filesystem::path, ThumbnailAtlas>;
+
+// Where a clip's thumbnail comes from: an atlas page and its tile, or a loose JPEG
+struct ThumbnailSource {
+    std::string image;   // empty: no thumbnail yet
+    ImVec2      uv0{0.0f, 0.0f};
+    ImVec2      uv1{1.0f, 1.0f};
+};
 
 class ThumbnailLoader {
 public:
     static ImTextureID LoadFromFile(const char* filename);
+    static ImTextureID CreateTexture(const unsigned char* rgba, int width, int height);
     static void FreeTexture(ImTextureID texture);
-    static void LoadThumbnails(std::vector<VideoInfo>& videos);
-    static void FreeThumbnails(std::vector<VideoInfo>& videos);
+
+    // Image to stream and UV rect for the table's rows from firstRow on, one
+    // entry per row in order. A folder's atlas index is read the first time it
+    // is seen and kept in atlases; clear the cache when the atlas is repacked.
+    static std::vector<ThumbnailSource> ResolveSources(const LibraryTable& table, ThumbnailAtlasCache& atlases,
+                                                       uint32_t firstRow = 0);
 
 private:
     ThumbnailLoader() = delete;  // Static-only class
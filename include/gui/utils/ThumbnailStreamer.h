@@ -0,0 +1,85 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "imgui.h"
+
+// Loads grid textures (atlas pages or loose thumbnail JPEGs) on demand.
+// The grid calls Request() for what is on screen each frame; a background
+// thread decodes the most recently requested images, and EndFrame() uploads a
+// bounded number of bytes per frame and evicts the least recently drawn
+// textures once the VRAM cap is exceeded. All GL work stays on the render thread.
+class ThumbnailStreamer {
+public:
+    static constexpr size_t kDefaultVramBudget = 256ull * 1024 * 1024;
+    static constexpr size_t kUploadBytesPerFrame = 16ull * 1024 * 1024;   // ~one atlas page
+
+    explicit ThumbnailStreamer(size_t vramBudgetBytes = kDefaultVramBudget);
+    ~ThumbnailStreamer();
+
+    ThumbnailStreamer(const ThumbnailStreamer&) = delete;
+    ThumbnailStreamer& operator=(const ThumbnailStreamer&) = delete;
+
+    // Texture if resident, otherwise 0 and the image is queued.
+    // visible = false marks a prefetch (just outside the viewport): lower priority.
+    ImTextureID Request(const std::string& path, bool visible = true);
+
+    // Uploads finished decodes within the frame budget, then enforces the cap
+    void EndFrame();
+
+    // Drops every texture and pending decode (e.g. after the atlas was repacked)
+    void Clear();
+
+    size_t GetResidentBytes() const { return m_residentBytes; }
+
+private:
+    static constexpr uint64_t kStaleFrames = 2;   // requests not renewed for this long are dropped
+
+    struct Resident {
+        ImTextureID texture  = 0;
+        size_t      bytes    = 0;
+        uint64_t    lastUsed = 0;
+    };
+
+    struct PendingRequest {
+        uint64_t frame   = 0;
+        bool     visible = false;
+    };
+
+    struct DecodedImage {
+        std::string    path;
+        unsigned char* pixels     = nullptr;   // RGBA, stbi-owned; null on failure
+        int            width      = 0;
+        int            height     = 0;
+        uint64_t       generation = 0;
+    };
+
+    void WorkerLoop();
+    void Evict();
+
+    // Render thread only
+    std::unordered_map<std::string, Resident> m_resident;
+    std::unordered_set<std::string>           m_failed;
+    std::deque<DecodedImage>                  m_ready;
+    size_t                                    m_residentBytes = 0;
+    size_t                                    m_vramBudget;
+
+    // Shared with the worker
+    std::mutex                                      m_mutex;
+    std::condition_variable                         m_cv;
+    std::unordered_map<std::string, PendingRequest> m_pending;
+    std::unordered_set<std::string>                 m_loading;   // decoding or awaiting upload
+    std::deque<DecodedImage>                        m_decoded;
+    uint64_t                                        m_frame      = 0;
+    uint64_t                                        m_generation = 0;
+    bool                                            m_quit       = false;
+
+    std::thread m_worker;   // last: started once everything above exists
+};
@@ -139,6 +139,17 @@ static AudioMode AudioModeFromStr(const std::string& s) {
     return AudioMode::Mixed;
 }
 
+static std::string HwDecodeModeToStr(HwDecodeMode v) {
+    if (v == HwDecodeMode::VAAPI) return "vaapi";
+    if (v == HwDecodeMode::Off)   return "off";
+    return "auto";
+}
+static HwDecodeMode HwDecodeModeFromStr(const std::string& s) {
+    if (s == "vaapi") return HwDecodeMode::VAAPI;
+    if (s == "off")   return HwDecodeMode::Off;
+    return HwDecodeMode::Auto;
+}
+
 // ─── InitializeOrCreateConfig ─────────────────────────────────────────────────
 std::optional<Config> Config::InitializeOrCreateConfig() {
     Config settings;
@@ -172,6 +183,9 @@ bool Config::Load() {
         startMinimized = cfg["general"]["start_minimized"].value_or(false);
         libraryPath    = cfg["general"]["library_path"].value_or<std::string>("");
 
+        hwDecode       = HwDecodeModeFromStr(cfg["decoding"]["hw_decode"].value_or<std::string>("auto"));
+        hwDecodeDevice = cfg["decoding"]["hw_device"].value_or<std::string>("");
+
         recordingMode      = cfg["recording"]["mode"].value_or<std::string>("native");
         recordingAutoStart = cfg["recording"]["auto_start"].value_or(false);
         hotkeyRecordToggle = cfg["recording"]["hotkey_record_toggle"].value_or<std::string>("F10");
@@ -246,6 +260,10 @@ bool Config::Save() const {
         file << "start_minimized = " << (startMinimized ? "true" : "false") << "\n";
         file << "library_path = \"" << libraryPath << "\"\n\n";
 
+        file << "[decoding]\n";
+        file << "hw_decode = \"" << HwDecodeModeToStr(hwDecode) << "\"\n";
+        file << "hw_device = \"" << hwDecodeDevice << "\"\n\n";
+
         file << "[recording]\n";
         file << "mode = \"" << recordingMode << "\"\n";
         file << "auto_start = " << (recordingAutoStart ? "true" : "false") << "\n";
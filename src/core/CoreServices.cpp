@@ -1,4 +1,5 @@
 #include "core/CoreServices.h"
+#include "core/media/HwDecoder.h"
 
 CoreServices::CoreServices() {
     if (auto loadedConfig = Config::InitializeOrCreateConfig(); loadedConfig.has_value()) {
@@ -27,14 +28,19 @@ void CoreServices::InitializeInternal() {
             m_config = std::make_unique<Config>(loadedConfig.value_or(Config()));
         }
 
+        HwDecoder::Configure(m_config->hwDecode, m_config->hwDecodeDevice);
+
         if (m_config->libraryPath.empty()) return;
 
         m_paths = ProjectPaths::FromFolder(m_config->libraryPath);
 
-        m_videoDatabase = std::make_unique<VideoDatabase>(m_paths.dbPath.string());
-        m_videoLibrary = std::make_unique<VideoLibrary>(m_paths);
+        m_videoDatabase = std::make_shared<VideoDatabase>(m_paths.dbPath.string());
+        m_videoLibrary = std::make_unique<VideoLibrary>(m_paths, m_videoDatabase);
         m_videoImportService = std::make_unique<VideoImportService>();
 
+        m_libraryWatcher = std::make_unique<LibraryWatcher>(m_paths.rootFolder, m_videoLibrary.get());
+        m_libraryWatcher->Start();
+
         m_initialized = true;
         std::cout << "[CoreServices] All services initialized successfully." << std::endl;
     } catch (const std::exception& e) {
@@ -54,6 +60,11 @@ void CoreServices::Shutdown() {
         m_recordingManager.reset();
     }
 
+    // Its thread syncs through the library, so it goes first
+    if (m_libraryWatcher) {
+        m_libraryWatcher.reset();
+    }
+
     if (m_videoLibrary) {
         std::cout << "[CoreServices] Stopping Video Library..." << std::endl;
         m_videoLibrary.reset();
@@ -63,11 +74,14 @@ void CoreServices::Shutdown() {
         m_videoImportService.reset();
     }
 
+    // Shared with the library, which has let go of it by now
     if (m_videoDatabase) {
         std::cout << "[CoreServices] Closing Database..." << std::endl;
         m_videoDatabase.reset();
     }
 
+    HwDecoder::Shutdown();
+
     if (m_config) {
         m_config.reset();
     }
@@ -2,17 +2,15 @@
 
 #include "core/library/VideoLibrary.h"
 #include "core/library/VideoDatabase.h"
+#include "core/media/MediaProbe.h"
 #include "core/media/ThumbnailService.h"
 #include "core/media/MetadataEmbedder.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
-#include <chrono>
-
-extern "C" {
-#include <libavformat/avformat.h>
-#include <libavcodec/avcodec.h>
-}
+#include <limits>
+#include <stdexcept>
 
 
 namespace fs = std::filesystem;
@@ -32,23 +30,56 @@ namespace logs{
 }
 
 
-VideoImportService::VideoImportService()
-    : m_isRunning(true)
-    , m_cancelRequested(false) {
+VideoImportService::VideoImportService(const ImportPipelineConfig& config)
+    : m_config(config)
+    , m_pending(std::numeric_limits<size_t>::max())
+    , m_probed(config.queueCapacity)
+    , m_thumbnailed(config.queueCapacity)
+    , m_embedded(config.queueCapacity) {
 
-    logs::LogInfo("Starting worker thread...");
-    m_importWorker = std::thread(&VideoImportService::ImportWorkerThread, this);
-    logs::LogInfo("Ready!");
+    if (m_config.thumbnailWorkers == 0) {
+        m_config.thumbnailWorkers = std::max(1u, std::thread::hardware_concurrency() / 2);
+    }
+
+    const auto spawn = [this](std::vector<std::thread>& workers, const size_t count,
+                              ItemQueue& input, ItemQueue& output,
+                              bool (VideoImportService::*stage)(ImportItem&) const) {
+        for (size_t i = 0; i < std::max<size_t>(count, 1); i++) {
+            workers.emplace_back(&VideoImportService::StageWorker, this,
+                                 std::ref(input), std::ref(output), stage);
+        }
+    };
+
+    spawn(m_probeWorkers,     m_config.probeWorkers,     m_pending,     m_probed,      &VideoImportService::ProbeStage);
+    spawn(m_thumbnailWorkers, m_config.thumbnailWorkers, m_probed,      m_thumbnailed, &VideoImportService::ThumbnailStage);
+    spawn(m_embedWorkers,     m_config.embedWorkers,     m_thumbnailed, m_embedded,    &VideoImportService::EmbedStage);
+    m_dbWriter = std::thread(&VideoImportService::DatabaseWriter, this);
+
+    logs::LogInfo("Ready! (" + std::to_string(m_probeWorkers.size()) + " probe, "
+                  + std::to_string(m_thumbnailWorkers.size()) + " thumbnail, "
+                  + std::to_string(m_embedWorkers.size()) + " embed workers)");
 }
 
 VideoImportService::~VideoImportService() {
     logs::LogInfo("Shutting down...");
 
-    m_isRunning = false;
+    // Queued files are dropped and in-flight ones stop at their next stage;
+    // then each stage is closed once the one feeding it has exited
+    CancelImport();
 
-    if (m_importWorker.joinable()) {
-        m_importWorker.join();
-    }
+    const auto stop = [](ItemQueue& input, std::vector<std::thread>& workers) {
+        input.Close();
+        for (auto& worker : workers) {
+            if (worker.joinable()) worker.join();
+        }
+    };
+
+    stop(m_pending,     m_probeWorkers);
+    stop(m_probed,      m_thumbnailWorkers);
+    stop(m_thumbnailed, m_embedWorkers);
+
+    m_embedded.Close();
+    if (m_dbWriter.joinable()) m_dbWriter.join();
 
     logs::LogInfo("Destroyed");
 }
@@ -58,23 +89,25 @@ void VideoImportService::ImportVideo(
     const std::string& videoPath,
     VideoLibrary* library,
     const ProgressCallback& callback) {
-    
+
     if (!library) {
         logs::LogError("VideoLibrary is null");
         return;
     }
 
-    logs::LogInfo("Queueing: " + videoPath);
-
-    ImportTask task;
-    task.videoPath = videoPath;
-    task.library = library;
-    task.callback = callback;
+    ImportItem item;
+    item.task.videoPath = videoPath;
+    item.task.library   = library;
+    item.task.callback  = callback;
+    item.generation     = m_generation.load();
 
     {
-        std::lock_guard lock(m_queueMutex);
-        m_importQueue.push(task);
-        logs::LogInfo("Queue size: " + std::to_string(m_importQueue.size()));
+        std::lock_guard lock(m_inFlightMutex);
+        m_inFlight++;
+    }
+
+    if (!m_pending.Push(std::move(item))) {
+        Finish();
     }
 }
 
@@ -94,26 +127,21 @@ void VideoImportService::ImportFolder(
 
     logs::LogInfo("Found " + std::to_string(videoFiles.size()) + " videos");
 
-    // Queue each video
-    for (const auto& videoPath : videoFiles) {
-        ImportVideo(videoPath, library, callback);
-    }
-
-    logs::LogInfo("All videos queued");
+    ImportMultiple(videoFiles, library, callback);
 }
 
 void VideoImportService::ImportMultiple(
     const std::vector<std::string>& videoPaths,
     VideoLibrary* library,
     const ProgressCallback& callback) {
-    
+
     if (!library) {
         logs::LogError("VideoLibrary is null");
         return;
     }
 
     logs::LogInfo("Queueing " + std::to_string(videoPaths.size()) + " videos");
-    
+
     for (const auto& videoPath : videoPaths) {
         ImportVideo(videoPath, library, callback);
     }
@@ -121,230 +149,182 @@ void VideoImportService::ImportMultiple(
 
 // QUEUE CONTROL
 bool VideoImportService::IsImporting() const {
-    std::lock_guard lock(m_queueMutex);
-    return !m_importQueue.empty();
+    std::lock_guard lock(m_inFlightMutex);
+    return m_inFlight > 0;
 }
 
 size_t VideoImportService::GetQueueSize() const {
-    std::lock_guard lock(m_queueMutex);
-    return m_importQueue.size();
+    std::lock_guard lock(m_inFlightMutex);
+    return m_inFlight;
 }
 
 void VideoImportService::CancelImport() {
     logs::LogInfo("Cancel requested");
-    m_cancelRequested = true;
 
-    std::lock_guard lock(m_queueMutex);
-    while (!m_importQueue.empty()) {
-        m_importQueue.pop();
+    // Files already past the probe stage notice the new generation and drop out
+    m_generation++;
+
+    for (const auto& item : m_pending.Drain()) {
+        Report(item, ImportStatus::FAILED, 0.0f, "Import cancelled");
+        Finish();
     }
 }
 
 void VideoImportService::WaitForCompletion() const {
     logs::LogInfo("Waiting for completion...");
 
-    while (IsImporting()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
+    std::unique_lock lock(m_inFlightMutex);
+    m_idle.wait(lock, [this] { return m_inFlight == 0; });
 
     logs::LogInfo("All imports complete");
 }
 
 
-// WORKER THREAD
-void VideoImportService::ImportWorkerThread() {
-    logs::LogWorker("Started");
-
-    while (m_isRunning) {
-        ImportTask task;
-        bool hasTask = false;
-
-        // Get task from queue
-        {
-            std::lock_guard lock(m_queueMutex);
-            if (!m_importQueue.empty()) {
-                task = m_importQueue.front();
-                m_importQueue.pop();
-                hasTask = true;
-                logs::LogWorker("Processing: " + task.videoPath);
-                logs::LogWorker("Remaining: " + std::to_string(m_importQueue.size()));
-            }
-        }
-
-        // No task, sleep
-        if (!hasTask) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+// PIPELINE
+void VideoImportService::StageWorker(ItemQueue& input, ItemQueue& output,
+                                     bool (VideoImportService::*stage)(ImportItem&) const) {
+    while (auto item = input.Pop()) {
+        if (item->generation != m_generation.load()) {
+            Report(*item, ImportStatus::FAILED, 0.0f, "Import cancelled");
+            Finish();
             continue;
         }
 
-        // Check cancel
-        if (m_cancelRequested) {
-            logs::LogWorker("Cancelled, skipping task");
-            m_cancelRequested = false;
+        try {
+            if (!(this->*stage)(*item)) {
+                Finish();
+                continue;
+            }
+        } catch (const std::exception& e) {
+            Fail(*item, e.what());
             continue;
         }
 
-        // Process task (outside mutex)
-        ProcessImportTask(task);
+        // Blocks while the next stage is backed up
+        if (!output.Push(std::move(*item))) {
+            Finish();
+        }
     }
-
-    logs::LogWorker("Stopped");
 }
 
-void VideoImportService::ProcessImportTask(const ImportTask& task) {
-    std::cout << "[ProcessTask] START: " << task.videoPath << std::endl;
-
-    ImportProgress progress;
-    progress.videoPath = task.videoPath;
-    progress.progress = 0.0f;
+bool VideoImportService::ProbeStage(ImportItem& item) const {
+    Report(item, ImportStatus::SCANNING, 0.1f, "Scanning video...");
 
-    try {
-        // STEP 1: SCANNING
-        std::cout << "  [1/5] Scanning with FFmpeg..." << std::endl;
-        progress.status = ImportStatus::SCANNING;
-        progress.message = "Scanning video...";
-        progress.progress = 0.1f;
-        if (task.callback) task.callback(progress);
-
-        VideoInfo info = ScanVideoWithFFmpeg(task.videoPath);
-        std::cout << "  Video: " << info.resolutionWidth << "x" << info.resolutionHeight
-                  << ", " << info.durationSec << "s" << std::endl;
-
-        // STEP 2: THUMBNAIL
-        std::cout << "  [2/5] Generating thumbnail..." << std::endl;
-        progress.status = ImportStatus::GENERATING_THUMBNAIL;
-        progress.message = "Creating thumbnail...";
-        progress.progress = 0.4f;
-        if (task.callback) task.callback(progress);
-
-        auto thumbService = task.library->GetThumbnailService();
-        if (thumbService) {
-            info.thumbnailPath = thumbService->GenerateThumbnail(task.videoPath);
-            std::cout << "  Thumbnail: " << info.thumbnailPath << std::endl;
-        }
+    // One open serves the scan, the embedded-metadata check and the thumbnail
+    item.probe       = std::make_unique<MediaProbe>(item.task.videoPath);
+    item.info        = ScanVideoWithFFmpeg(*item.probe);
+    item.hasEmbedded = MetadataEmbedder::HasEmbeddedMetadata(*item.probe);
 
-        // STEP 3: EMBED METADATA
-        std::cout << "  [3/5] Embedding metadata..." << std::endl;
-        progress.status = ImportStatus::EMBEDDING_METADATA;
-        progress.message = "Writing metadata to video...";
-        progress.progress = 0.6f;
-        if (task.callback) task.callback(progress);
-
-        auto embedder = task.library->GetMetadataEmbedder();
-        if (embedder) {
-            if (!embedder->HasEmbeddedMetadata(task.videoPath)) {
-                embedder->WriteMetadataToVideo(task.videoPath, info);
-                std::cout << "  Metadata embedded" << std::endl;
-            } else {
-                std::cout << "  Metadata already exists" << std::endl;
-            }
-        }
-
-        // STEP 4: SAVE TO DATABASE
-        std::cout << "  [4/5] Saving to database..." << std::endl;
-        progress.status = ImportStatus::SAVING_TO_DB;
-        progress.message = "Saving to database...";
-        progress.progress = 0.9f;
-        if (task.callback) task.callback(progress);
-
-        auto database = task.library->GetDatabase();
-        if (database) {
-            database->SaveMetadata(info);
-            std::cout << "  Saved to database" << std::endl;
-        }
-
-        // STEP 5: COMPLETED
-        std::cout << "  [5/5] Completed!" << std::endl;
-        progress.status = ImportStatus::COMPLETED;
-        progress.message = "Import complete!";
-        progress.progress = 1.0f;
-        if (task.callback) task.callback(progress);
-
-        std::cout << "[ProcessTask] SUCCESS" << std::endl;
+    if (item.hasEmbedded) {
+        item.info.appVersion = item.probe->GetTags().at("app_version");
+    }
+    return true;
+}
 
-    } catch (const std::exception& e) {
-        std::cerr << "[ProcessTask] ERROR: " << e.what() << std::endl;
+bool VideoImportService::ThumbnailStage(ImportItem& item) const {
+    Report(item, ImportStatus::GENERATING_THUMBNAIL, 0.4f, "Creating thumbnail...");
 
-        progress.status = ImportStatus::FAILED;
-        progress.message = std::string("Error: ") + e.what();
-        progress.progress = 0.0f;
-        if (task.callback) task.callback(progress);
+    if (auto* thumbService = item.task.library->GetThumbnailService()) {
+        item.info.thumbnailPath = thumbService->GenerateThumbnail(
+            *item.probe, ThumbnailStrategy::KEYFRAME_NEAR_1SEC);
     }
+
+    // Done reading; the embed stage may rewrite the file
+    item.probe.reset();
+    return true;
 }
 
-VideoInfo VideoImportService::ScanVideoWithFFmpeg(const std::string& videoPath) {
-    VideoInfo info;
-    info.filePath = videoPath;
-    info.filePathString = videoPath;
-    info.name = fs::path(videoPath).filename().string();
+bool VideoImportService::EmbedStage(ImportItem& item) const {
+    Report(item, ImportStatus::EMBEDDING_METADATA, 0.6f, "Writing metadata to video...");
 
-    // Get file size and modification time
-    try {
-        if (fs::exists(videoPath)) {
-            info.fileSize = fs::file_size(videoPath);
-            auto ftime = fs::last_write_time(videoPath);
-            auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-                ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()
-            );
-            info.lastModified = std::chrono::system_clock::to_time_t(sctp);
+    if (!item.hasEmbedded) {
+        if (const auto* embedder = item.task.library->GetMetadataEmbedder();
+            embedder && embedder->WriteMetadataToVideo(item.task.videoPath, item.info)) {
+            if (item.info.appVersion.empty()) item.info.appVersion = MetadataEmbedder::DEFAULT_APP_VERSION;
         }
-    } catch (const std::exception& e) {
-        logs::LogError("File stat error: " + std::string(e.what()));
-        info.fileSize = 0;
-        info.lastModified = 0;
     }
 
-    // Open video with FFmpeg
-    AVFormatContext* formatCtx = nullptr;
+    // Taken after embedding changed the file
+    item.info.fingerprint = FileFingerprint::Read(item.task.videoPath).value_or(FileFingerprint{});
+    return true;
+}
 
-    try {
-        int ret = avformat_open_input(&formatCtx, videoPath.c_str(), nullptr, nullptr);
-        if (ret < 0) {
-            char errbuf[256];
-            av_strerror(ret, errbuf, sizeof(errbuf));
-            throw std::runtime_error(std::string("Failed to open video: ") + errbuf);
-        }
+void VideoImportService::DatabaseWriter() {
+    std::vector<ImportItem> batch;
+    std::vector<VideoInfo>  rows;
+
+    while (m_embedded.PopBatch(batch, m_config.dbBatchSize) > 0) {
+        // One transaction per library in the batch (normally just one)
+        for (size_t start = 0; start < batch.size(); ) {
+            VideoLibrary* library = batch[start].task.library;
+
+            size_t end = start;
+            rows.clear();
+            while (end < batch.size() && batch[end].task.library == library) {
+                Report(batch[end], ImportStatus::SAVING_TO_DB, 0.9f, "Saving to database...");
+                rows.push_back(batch[end].info);
+                end++;
+            }
 
-        ret = avformat_find_stream_info(formatCtx, nullptr);
-        if (ret < 0) {
-            avformat_close_input(&formatCtx);
-            char errbuf[256];
-            av_strerror(ret, errbuf, sizeof(errbuf));
-            throw std::runtime_error(std::string("Failed to find stream info: ") + errbuf);
-        }
+            try {
+                if (auto* database = library->GetDatabase()) {
+                    database->SaveMetadataBatch(rows);
+                }
+                for (size_t i = start; i < end; i++) {
+                    Report(batch[i], ImportStatus::COMPLETED, 1.0f, "Import complete!");
+                    Finish();
+                }
+            } catch (const std::exception& e) {
+                for (size_t i = start; i < end; i++) Fail(batch[i], e.what());
+            }
 
-        // Duration
-        if (formatCtx->duration != AV_NOPTS_VALUE) {
-            info.durationSec = static_cast<double>(formatCtx->duration) / AV_TIME_BASE;
+            start = end;
         }
 
-        // Find video stream
-        bool foundVideo = false;
-        for (unsigned i = 0; i < formatCtx->nb_streams; i++) {
-            const AVStream* stream = formatCtx->streams[i];
-            if (!stream || !stream->codecpar) continue;
-
-            if (stream->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
-                info.resolutionWidth  = stream->codecpar->width;
-                info.resolutionHeight = stream->codecpar->height;
-                foundVideo = true;
-                break;
-            }
-        }
+        logs::LogWorker("Saved " + std::to_string(batch.size()) + " imported videos");
+        batch.clear();
+    }
+}
 
-        avformat_close_input(&formatCtx);
+void VideoImportService::Report(const ImportItem& item,
+                                const ImportStatus status,
+                                const float progress,
+                                const std::string& message) {
+    if (!item.task.callback) return;
+
+    ImportProgress update;
+    update.videoPath = item.task.videoPath;
+    update.status    = status;
+    update.progress  = progress;
+    update.message   = message;
+    item.task.callback(update);
+}
 
-        if (!foundVideo) {
-            throw std::runtime_error("No video stream found in file");
-        }
+void VideoImportService::Fail(const ImportItem& item, const std::string& error) {
+    logs::LogError(item.task.videoPath + ": " + error);
+    Report(item, ImportStatus::FAILED, 0.0f, "Error: " + error);
+    Finish();
+}
 
-    } catch (const std::exception& e) {
-        if (formatCtx) {
-            avformat_close_input(&formatCtx);
-        }
-        throw;
+void VideoImportService::Finish() {
+    {
+        std::lock_guard lock(m_inFlightMutex);
+        if (m_inFlight > 0) m_inFlight--;
+        if (m_inFlight > 0) return;
+    }
+    m_idle.notify_all();
+}
+
+VideoInfo VideoImportService::ScanVideoWithFFmpeg(const MediaProbe& probe) {
+    if (!probe.IsOpen()) {
+        throw std::runtime_error("Failed to open video: " + probe.GetPath());
+    }
+    if (!probe.HasVideo()) {
+        throw std::runtime_error("No video stream found in file");
     }
 
+    VideoInfo info;
+    probe.FillVideoInfo(info);
     return info;
 }
 
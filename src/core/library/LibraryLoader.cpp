@@ -1,7 +1,13 @@
 #include "core/library/LibraryLoader.h"
+#include "core/library/VideoDatabase.h"
 #include "core/library/VideoLibrary.h"
 
+#include "core/FileFingerprint.h"
+
 #include <filesystem>
+#include <mutex>
+#include <optional>
+#include <ranges>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -10,10 +16,15 @@ namespace fs = std::filesystem;
 namespace lL{
     constexpr float SCAN_PROGRESS = 0.1f;
     constexpr float LOAD_START = 0.1f;
-    constexpr float LOAD_END = 0.8f;
-    constexpr float THUMBNAIL_PROGRESS = 0.95f;
+    constexpr float LOAD_END = 0.95f;
     constexpr float COMPLETE_PROGRESS = 1.0f;
 
+    // Maintenance reports on its own 0..1 scale
+    constexpr float INTEGRITY_PROGRESS = 0.0f;
+    constexpr float THUMBNAIL_PROGRESS = 0.1f;
+    constexpr float THUMBNAIL_END = 0.9f;
+    constexpr float ATLAS_PROGRESS = 0.9f;
+
     // Logging Helper
     void NotifyProgress(const LibraryLoader::ProgressCallback& callback,
                        const std::string& message,
@@ -48,30 +59,100 @@ namespace lL{
         return videoFiles;
     }
 
-    void LoadVideos(VideoLibrary* library,
-                   const std::vector<fs::path>& videoFiles,
-                   const LibraryLoader::ProgressCallback& onProgress) {
-        if (videoFiles.empty()) {
-            NotifyProgress(onProgress, "No videos found.", COMPLETE_PROGRESS);
-            return;
+    // What changed on disk since the last sync, by stored fingerprint
+    struct LibraryDiff {
+        std::vector<fs::path>    added;
+        std::vector<fs::path>    changed;
+        std::vector<fs::path>    backfill;   // rows saved before fingerprints existed
+        std::vector<std::string> removed;
+        size_t                   unchanged = 0;
+
+        size_t WorkCount() const { return added.size() + changed.size() + backfill.size() + removed.size(); }
+    };
+
+    LibraryDiff DiffLibrary(VideoLibrary* library,
+                            const std::vector<fs::path>& videoFiles,
+                            const bool detectRemovals) {
+        LibraryDiff diff;
+        auto stored = library->GetDatabase()->GetFingerprints();
+
+        for (const auto& videoFile : videoFiles) {
+            const auto current = FileFingerprint::Read(videoFile.string());
+            if (!current) continue;
+
+            const auto it = stored.find(videoFile.string());
+            if (it == stored.end()) {
+                diff.added.push_back(videoFile);
+                continue;
+            }
+
+            if (it->second == *current)       diff.unchanged++;
+            else if (!it->second.IsValid())   diff.backfill.push_back(videoFile);
+            else                              diff.changed.push_back(videoFile);
+
+            stored.erase(it);
         }
 
-        NotifyProgress(onProgress,
-                      std::to_string(videoFiles.size()) + " video(s) found.",
-                      SCAN_PROGRESS);
+        // Records not seen in the scan are only dropped once the file is really gone
+        if (detectRemovals) {
+            for (const auto& path : stored | std::views::keys) {
+                if (!fs::exists(path)) diff.removed.push_back(path);
+            }
+        }
 
-        for (size_t i = 0; i < videoFiles.size(); ++i) {
-            const auto& videoFile = videoFiles[i];
-            const std::string fileName = videoFile.filename().string();
+        return diff;
+    }
+
+    void ApplyDiff(VideoLibrary* library,
+                   const LibraryDiff& diff,
+                   const LibraryLoader::ProgressCallback& onProgress) {
+        const size_t total = diff.WorkCount();
+        size_t done = 0;
+
+        const auto step = [&](const std::string& message) {
+            const float progress = LOAD_START + (LOAD_END - LOAD_START) *
+                                   (static_cast<float>(done++) / static_cast<float>(total));
+            NotifyProgress(onProgress, message, progress);
+            return progress;
+        };
+
+        // All record changes land in one transaction
+        VideoDatabase* database = library->GetDatabase();
+        database->BeginBatch();
+
+        for (const auto& path : diff.removed) {
+            step("Removed: " + fs::path(path).filename().string());
+            library->RemoveMissingVideo(path);
+        }
+
+        for (const auto& videoFile : diff.backfill) {
+            step("Indexing: " + videoFile.filename().string());
+            if (const auto video = library->GetVideo(videoFile.string())) {
+                VideoInfo info = *video;
+                info.fingerprint = FileFingerprint::Read(videoFile.string()).value_or(FileFingerprint{});
+                library->SaveVideo(info);
+            }
+        }
 
-            const float progress = LOAD_START +
-                                 (LOAD_END - LOAD_START) *
-                                 (static_cast<float>(i) / videoFiles.size());
+        for (const auto& videoFile : diff.changed) {
+            const float progress = step("Updating: " + videoFile.filename().string());
+            try {
+                library->RefreshVideo(videoFile.string());
+            } catch (const std::exception& e) {
+                NotifyProgress(onProgress,
+                              std::string("Error updating: ") + videoFile.filename().string() +
+                              " (" + e.what() + ")",
+                              progress);
+            }
+        }
 
-            NotifyProgress(onProgress, "Loading: " + fileName, progress);
+        for (const auto& videoFile : diff.added) {
+            const std::string fileName = videoFile.filename().string();
+            const float progress = step("Loading: " + fileName);
 
             try {
-                library->LoadVideo(videoFile.string());
+                // Thumbnails are batched onto the worker pool afterwards
+                library->LoadVideo(videoFile.string(), false);
             } catch (const std::exception& e) {
                 NotifyProgress(onProgress,
                               std::string("Error loading: ") + fileName +
@@ -79,19 +160,41 @@ namespace lL{
                               progress);
             }
         }
+
+        database->CommitBatch();
     }
 
     void GenerateThumbnails(VideoLibrary* library,
                            const LibraryLoader::ProgressCallback& onProgress) {
         try {
             NotifyProgress(onProgress, "Generating thumbnails...", THUMBNAIL_PROGRESS);
-            library->RegenerateMissingThumbnails();
+            library->RegenerateMissingThumbnails([&onProgress](const size_t done, const size_t total) {
+                const float progress = THUMBNAIL_PROGRESS +
+                                       (THUMBNAIL_END - THUMBNAIL_PROGRESS) *
+                                       (static_cast<float>(done) / static_cast<float>(total));
+                NotifyProgress(onProgress,
+                               "Thumbnails: " + std::to_string(done) + "/" + std::to_string(total),
+                               progress);
+            });
         } catch (const std::exception& e) {
             NotifyProgress(onProgress,
                           std::string("Error generating thumbnails: ") + e.what(),
                           -1.0f);
         }
     }
+
+    // Changed or duration-less rows only, in parallel; unchanged ones cost a stat
+    void CheckIntegrity(VideoLibrary* library,
+                        const LibraryLoader::ProgressCallback& onProgress) {
+        NotifyProgress(onProgress, "Checking video integrity...", INTEGRITY_PROGRESS);
+        library->CleanupOrphanedRecords();
+    }
+
+    void PackThumbnails(const VideoLibrary* library,
+                        const LibraryLoader::ProgressCallback& onProgress) {
+        NotifyProgress(onProgress, "Packing thumbnails...", ATLAS_PROGRESS);
+        library->PackThumbnailAtlas();
+    }
 }
 
 // Public API
@@ -115,19 +218,90 @@ void LibraryLoader::Run(VideoLibrary* library,
         return;
     }
 
+    // One sync at a time: the watcher may be flushing while this runs
+    std::lock_guard lock(library->SyncMutex());
+
     const auto videoFiles = lL::ScanVideoFiles(libraryPath, onProgress);
 
+    // Compare against stored fingerprints; unchanged files are not touched
+    const auto diff = lL::DiffLibrary(library, videoFiles, true);
+
+    lL::NotifyProgress(onProgress,
+                      std::to_string(videoFiles.size()) + " video(s) found: " +
+                      std::to_string(diff.added.size()) + " new, " +
+                      std::to_string(diff.changed.size()) + " changed, " +
+                      std::to_string(diff.removed.size()) + " removed.",
+                      lL::SCAN_PROGRESS);
+
+    if (diff.WorkCount() > 0) {
+        lL::ApplyDiff(library, diff, onProgress);
+    }
+
     if (videoFiles.empty()) {
         lL::NotifyProgress(onProgress, "No videos found in selected folder.", lL::COMPLETE_PROGRESS);
         return;
     }
 
-    // Load videos into library
-    lL::LoadVideos(library, videoFiles, onProgress);
+    // Complete; thumbnails and integrity follow in RunMaintenance
+    lL::NotifyProgress(onProgress, "Library ready!", lL::COMPLETE_PROGRESS);
+}
+
+void LibraryLoader::RunMaintenance(VideoLibrary* library, const ProgressCallback& onProgress) {
+    if (!library) return;
+
+    // Each pass takes the sync lock on its own, so a clip saved meanwhile
+    // waits for one pass rather than all of them
+    {
+        std::lock_guard lock(library->SyncMutex());
+        lL::CheckIntegrity(library, onProgress);
+    }
 
     // Generate missing thumbnails
-    lL::GenerateThumbnails(library, onProgress);
+    {
+        std::lock_guard lock(library->SyncMutex());
+        lL::GenerateThumbnails(library, onProgress);
+    }
+
+    // Pack them into atlas pages for the grid
+    {
+        std::lock_guard lock(library->SyncMutex());
+        lL::PackThumbnails(library, onProgress);
+    }
+
+    lL::NotifyProgress(onProgress, "Library maintenance done", lL::COMPLETE_PROGRESS);
+}
+
+bool LibraryLoader::SyncFile(VideoLibrary* library,
+                             const std::string& videoPath,
+                             const ProgressCallback& onProgress) {
+    if (!library || videoPath.empty()) return false;
 
-    // Complete
+    std::lock_guard lock(library->SyncMutex());
+
+    // Classified against its own row only, and only its atlas tile is packed,
+    // so a watcher event costs the same however large the library is
+    std::optional<FileFingerprint> stored;
+    if (const auto video = library->GetVideo(videoPath)) stored = video->fingerprint;
+
+    lL::LibraryDiff diff;
+    if (const auto current = FileFingerprint::Read(videoPath)) {
+        if (!stored)                   diff.added.push_back(videoPath);
+        else if (*stored == *current)  diff.unchanged++;
+        else if (!stored->IsValid())   diff.backfill.push_back(videoPath);
+        else                           diff.changed.push_back(videoPath);
+    } else if (stored) {
+        diff.removed.push_back(videoPath);
+    }
+
+    if (diff.WorkCount() == 0) return false;
+    lL::ApplyDiff(library, diff, onProgress);
+
+    // Just this clip's thumbnail, then its atlas page; a removed clip's tile
+    // is dropped by the next full pack
+    if (!diff.added.empty() || !diff.changed.empty()) {
+        library->EnsureThumbnail(videoPath);
+        library->PackThumbnail(videoPath);
+    }
     lL::NotifyProgress(onProgress, "Library ready!", lL::COMPLETE_PROGRESS);
-}
\ No newline at end of file
+    return true;
+}
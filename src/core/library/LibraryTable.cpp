@@ -0,0 +1,64 @@
+#include "core/library/LibraryTable.h"
+
+#include <utility>
+
+namespace {
+    // Folder and file name; the folder is empty for a bare name
+    std::pair<std::string_view, std::string_view> SplitPath(const std::string_view path) {
+        const size_t slash = path.rfind('/');
+        if (slash == std::string_view::npos) return {{}, path};
+        return {path.substr(0, slash), path.substr(slash + 1)};
+    }
+}
+
+LibraryTable::RowId LibraryTable::Append(const VideoInfo& video) {
+    const auto row = static_cast<RowId>(Size());
+
+    const auto [folder, fileName] = SplitPath(video.filePathString);
+    m_videoFolders.push_back(InternFolder(folder));
+
+    const TextRef name = AppendText(video.name);
+    m_names.push_back(name);
+    m_fileNames.push_back(fileName == video.name ? name : AppendText(fileName));
+
+    const auto [thumbFolder, thumbName] = SplitPath(video.thumbnailPath);
+    m_thumbnailFolders.push_back(InternFolder(thumbFolder));
+    m_thumbnailNames.push_back(AppendText(thumbName));
+    return row;
+}
+
+uint32_t LibraryTable::InternFolder(const std::string_view folder) {
+    const auto [it, inserted] = m_folderIds.try_emplace(std::string(folder), static_cast<uint32_t>(m_folders.size()));
+    if (inserted) m_folders.push_back(AppendText(folder));
+    return it->second;
+}
+
+LibraryTable::TextRef LibraryTable::AppendText(const std::string_view text) {
+    const TextRef ref{static_cast<uint32_t>(m_arena.size()), static_cast<uint32_t>(text.size())};
+    m_arena.append(text);
+    return ref;
+}
+
+std::string LibraryTable::GetPath(const RowId row) const {
+    const std::string_view folder = Text(m_folders[m_videoFolders[row]]);
+    const std::string_view file   = Text(m_fileNames[row]);
+    if (folder.empty()) return std::string(file);
+
+    std::string path;
+    path.reserve(folder.size() + 1 + file.size());
+    path.append(folder).append("/").append(file);
+    return path;
+}
+
+std::string LibraryTable::GetThumbnailPath(const RowId row) const {
+    if (!HasThumbnail(row)) return {};
+
+    const std::string_view folder = Text(m_folders[m_thumbnailFolders[row]]);
+    const std::string_view file   = Text(m_thumbnailNames[row]);
+    if (folder.empty()) return std::string(file);
+
+    std::string path;
+    path.reserve(folder.size() + 1 + file.size());
+    path.append(folder).append("/").append(file);
+    return path;
+}
@@ -0,0 +1,151 @@
+#include "core/library/LibraryWatcher.h"
+#include "core/library/LibraryLoader.h"
+#include "core/library/VideoLibrary.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+LibraryWatcher::LibraryWatcher(fs::path folder, VideoLibrary* library)
+    : m_folder(std::move(folder)), m_library(library) {}
+
+LibraryWatcher::~LibraryWatcher() {
+    Stop();
+}
+
+bool LibraryWatcher::Start() {
+    if (IsRunning() || !m_library) return IsRunning();
+
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0) {
+        std::cerr << "[LibraryWatcher] inotify_init1 failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    constexpr uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM | IN_ONLYDIR;
+    m_watchFd = inotify_add_watch(m_inotifyFd, m_folder.c_str(), mask);
+    m_wakeFd  = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (m_watchFd < 0 || m_wakeFd < 0) {
+        std::cerr << "[LibraryWatcher] Cannot watch " << m_folder << ": " << std::strerror(errno) << std::endl;
+        Stop();
+        return false;
+    }
+
+    m_thread = std::thread(&LibraryWatcher::WatchLoop, this);
+    std::cout << "[LibraryWatcher] Watching " << m_folder << std::endl;
+    return true;
+}
+
+void LibraryWatcher::Stop() {
+    if (m_thread.joinable()) {
+        constexpr uint64_t one = 1;
+        [[maybe_unused]] const auto written = write(m_wakeFd, &one, sizeof(one));
+        m_thread.join();
+    }
+
+    if (m_wakeFd >= 0)    { close(m_wakeFd);    m_wakeFd = -1; }
+    if (m_inotifyFd >= 0) { close(m_inotifyFd); m_inotifyFd = -1; }   // drops the watch too
+    m_watchFd = -1;
+}
+
+void LibraryWatcher::SetOnChanged(OnChanged cb) {
+    std::lock_guard lock(m_callbackMutex);
+    m_onChanged = std::move(cb);
+}
+
+bool LibraryWatcher::IsWatchedFile(const fs::path& path) {
+    const std::string name = path.filename().string();
+    if (name.empty() || name.front() == '.') return false;
+    if (name.find(".temp.") != std::string::npos) return false;
+    return VideoLibrary::IsVideoFile(path);
+}
+
+// ─── Watch Thread ─────────────────────────────────────────────────────────────
+
+void LibraryWatcher::WatchLoop() {
+    std::unordered_set<std::string> pending;
+    bool overflowed = false;
+
+    pollfd fds[2] = {
+        { m_inotifyFd, POLLIN, 0 },
+        { m_wakeFd,    POLLIN, 0 },
+    };
+
+    while (true) {
+        // Block until something happens; once events are pending, wait only
+        // until the folder has been quiet for the settle window
+        const int timeout = pending.empty() && !overflowed ? -1 : kSettleMs;
+        const int ready = poll(fds, 2, timeout);
+
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[LibraryWatcher] poll failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (fds[1].revents & POLLIN) break;
+
+        if (ready == 0) {
+            Flush(pending, overflowed);
+            overflowed = false;
+            continue;
+        }
+        if (fds[0].revents & POLLIN) ReadEvents(pending, overflowed);
+    }
+}
+
+void LibraryWatcher::ReadEvents(std::unordered_set<std::string>& pending, bool& overflowed) const {
+    alignas(inotify_event) char buffer[16 * 1024];
+
+    while (true) {
+        const ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) break;   // EAGAIN: drained
+
+        for (const char* p = buffer; p < buffer + length; ) {
+            const auto* event = reinterpret_cast<const inotify_event*>(p);
+            p += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) { overflowed = true; continue; }
+            if (event->mask & IN_IGNORED) {
+                std::cerr << "[LibraryWatcher] Watch on " << m_folder << " was removed" << std::endl;
+                continue;
+            }
+            if (event->len == 0 || (event->mask & IN_ISDIR)) continue;
+
+            const fs::path path = m_folder / event->name;
+            if (IsWatchedFile(path)) pending.insert(path.string());
+        }
+    }
+}
+
+void LibraryWatcher::Flush(std::unordered_set<std::string>& pending, const bool overflowed) {
+    // The kernel dropped events: fall back to a fingerprint diff of the folder
+    if (overflowed) {
+        std::cout << "[LibraryWatcher] Event queue overflowed, resyncing folder" << std::endl;
+        pending.clear();
+        LibraryLoader::Run(m_library, m_folder.string());
+        Notify({});
+        LibraryLoader::RunMaintenance(m_library);
+        Notify({});
+        return;
+    }
+
+    // SyncFile works out from the file itself whether it was added, changed or
+    // removed, and does nothing if its fingerprint still matches
+    for (const auto& path : pending) {
+        if (LibraryLoader::SyncFile(m_library, path)) Notify(path);
+    }
+    pending.clear();
+}
+
+void LibraryWatcher::Notify(const fs::path& videoPath) {
+    std::lock_guard lock(m_callbackMutex);
+    if (m_onChanged) m_onChanged(videoPath);
+}
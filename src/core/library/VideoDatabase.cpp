@@ -1,13 +1,216 @@
 #include "core/library/VideoDatabase.h"
+#include "core/media/MediaProbe.h"
 
 #include <sqlite3.h>
-#include <chrono>
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <ranges>
+#include <utility>
+#include <variant>
 
 namespace fs = std::filesystem;
 
+namespace {
+    // Explicit column order shared by SELECT and INSERT, so migrated tables
+    // (columns appended by ALTER TABLE) read and write the same way as new ones
+    constexpr const char* kVideoColumns =
+        "file_path, file_name, file_size, duration_sec, frame_rate, "
+        "resolution_width, resolution_height, thumbnail_path, is_favorite, "
+        "clip_start_point, clip_end_point, recording_time_ms, last_edit_time_ms, "
+        "app_version, fp_inode, fp_size, fp_mtime_ns";
+
+    // What the grid draws; GetGridPage reads these and nothing else
+    constexpr const char* kGridColumns =
+        "file_path, file_name, file_size, duration_sec, resolution_width, "
+        "resolution_height, thumbnail_path, is_favorite, recording_time_ms";
+
+    // Columns added after the first release: name → definition
+    constexpr std::pair<const char*, const char*> kAddedColumns[] = {
+        {"fp_inode",    "INTEGER DEFAULT 0"},
+        {"fp_size",     "INTEGER DEFAULT 0"},
+        {"fp_mtime_ns", "INTEGER DEFAULT 0"},
+    };
+
+    // One-row aggregate table. The triggers apply each row change as a delta,
+    // so statistics never scan `videos`. REPLACE only fires the delete trigger
+    // for the row it displaces with recursive_triggers on (set per connection).
+    constexpr const char* kStatsSchema = R"(
+        CREATE TABLE IF NOT EXISTS library_stats (
+            id                 INTEGER PRIMARY KEY CHECK (id = 1),
+            video_count        INTEGER NOT NULL DEFAULT 0,
+            total_duration_sec REAL    NOT NULL DEFAULT 0,
+            total_size_bytes   INTEGER NOT NULL DEFAULT 0,
+            with_thumbnail     INTEGER NOT NULL DEFAULT 0,
+            with_metadata      INTEGER NOT NULL DEFAULT 0
+        );
+
+        CREATE TRIGGER IF NOT EXISTS library_stats_insert AFTER INSERT ON videos BEGIN
+            UPDATE library_stats SET
+                video_count        = video_count + 1,
+                total_duration_sec = total_duration_sec + IFNULL(NEW.duration_sec, 0),
+                total_size_bytes   = total_size_bytes + IFNULL(NEW.file_size, 0),
+                with_thumbnail     = with_thumbnail + (IFNULL(NEW.thumbnail_path, '') <> ''),
+                with_metadata      = with_metadata + (IFNULL(NEW.app_version, '') <> '')
+            WHERE id = 1;
+        END;
+
+        CREATE TRIGGER IF NOT EXISTS library_stats_delete AFTER DELETE ON videos BEGIN
+            UPDATE library_stats SET
+                video_count        = video_count - 1,
+                total_duration_sec = total_duration_sec - IFNULL(OLD.duration_sec, 0),
+                total_size_bytes   = total_size_bytes - IFNULL(OLD.file_size, 0),
+                with_thumbnail     = with_thumbnail - (IFNULL(OLD.thumbnail_path, '') <> ''),
+                with_metadata      = with_metadata - (IFNULL(OLD.app_version, '') <> '')
+            WHERE id = 1;
+        END;
+
+        CREATE TRIGGER IF NOT EXISTS library_stats_update AFTER UPDATE ON videos BEGIN
+            UPDATE library_stats SET
+                total_duration_sec = total_duration_sec - IFNULL(OLD.duration_sec, 0) + IFNULL(NEW.duration_sec, 0),
+                total_size_bytes   = total_size_bytes - IFNULL(OLD.file_size, 0) + IFNULL(NEW.file_size, 0),
+                with_thumbnail     = with_thumbnail - (IFNULL(OLD.thumbnail_path, '') <> '')
+                                                    + (IFNULL(NEW.thumbnail_path, '') <> ''),
+                with_metadata      = with_metadata - (IFNULL(OLD.app_version, '') <> '')
+                                                   + (IFNULL(NEW.app_version, '') <> '')
+            WHERE id = 1;
+        END;
+    )";
+
+    // Fills the aggregate from scratch; a full scan, so only when the row is
+    // missing (a new table, or a file written without the stats schema)
+    constexpr const char* kStatsReconcile = R"(
+        INSERT OR REPLACE INTO library_stats
+            (id, video_count, total_duration_sec, total_size_bytes, with_thumbnail, with_metadata)
+        SELECT 1,
+               COUNT(*),
+               IFNULL(SUM(duration_sec), 0),
+               IFNULL(SUM(file_size), 0),
+               IFNULL(SUM(IFNULL(thumbnail_path, '') <> ''), 0),
+               IFNULL(SUM(IFNULL(app_version, '') <> ''), 0)
+        FROM videos;
+    )";
+
+    // File-name index for substring search. The trigram tokenizer matches any
+    // run of three or more characters, case-insensitively, like the old
+    // std::string::find did (minus the case). External content: the text
+    // lives in `videos`, the triggers keep the index in step by rowid.
+    constexpr const char* kSearchSchema = R"(
+        CREATE VIRTUAL TABLE IF NOT EXISTS videos_fts USING fts5(
+            file_name, content='videos', content_rowid='rowid', tokenize='trigram'
+        );
+
+        CREATE TRIGGER IF NOT EXISTS videos_fts_insert AFTER INSERT ON videos BEGIN
+            INSERT INTO videos_fts(rowid, file_name) VALUES (NEW.rowid, NEW.file_name);
+        END;
+
+        CREATE TRIGGER IF NOT EXISTS videos_fts_delete AFTER DELETE ON videos BEGIN
+            INSERT INTO videos_fts(videos_fts, rowid, file_name) VALUES ('delete', OLD.rowid, OLD.file_name);
+        END;
+
+        CREATE TRIGGER IF NOT EXISTS videos_fts_update AFTER UPDATE OF file_name ON videos BEGIN
+            INSERT INTO videos_fts(videos_fts, rowid, file_name) VALUES ('delete', OLD.rowid, OLD.file_name);
+            INSERT INTO videos_fts(rowid, file_name) VALUES (NEW.rowid, NEW.file_name);
+        END;
+    )";
+
+    // sqlite3_column_text is null for NULL columns (rows written by other
+    // tools, or columns added by a migration); those read as empty
+    std::string ColumnText(sqlite3_stmt* stmt, const int column) {
+        const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, column));
+        return text ? std::string(text, static_cast<size_t>(sqlite3_column_bytes(stmt, column))) : std::string();
+    }
+
+    // ─── Query building ───
+
+    using QueryValue = std::variant<int64_t, double, std::string>;
+
+    struct QueryFilter {
+        std::string             where;    // empty or " WHERE ..."
+        std::vector<QueryValue> values;   // in placeholder order
+    };
+
+    size_t CountCodepoints(const std::string& text) {
+        return static_cast<size_t>(std::ranges::count_if(text, [](const unsigned char c) { return (c & 0xC0) != 0x80; }));
+    }
+
+    // The text as one FTS5 phrase, so operators and quotes in it are literal
+    std::string FtsPhrase(const std::string& text) {
+        std::string phrase = "\"";
+        for (const char c : text) {
+            if (c == '"') phrase += '"';
+            phrase += c;
+        }
+        return phrase + "\"";
+    }
+
+    std::string LikePattern(const std::string& text) {
+        std::string pattern = "%";
+        for (const char c : text) {
+            if (c == '%' || c == '_' || c == '\\') pattern += '\\';
+            pattern += c;
+        }
+        return pattern + "%";
+    }
+
+    QueryFilter BuildFilter(const VideoQuery& query, const bool useFts) {
+        QueryFilter filter;
+        std::vector<std::string> clauses;
+
+        const auto add = [&](const char* clause, QueryValue value) {
+            clauses.emplace_back(clause);
+            filter.values.push_back(std::move(value));
+        };
+
+        if (!query.text.empty()) {
+            // Trigrams need three characters; shorter text scans with LIKE
+            if (useFts && CountCodepoints(query.text) >= 3) {
+                add("rowid IN (SELECT rowid FROM videos_fts WHERE videos_fts MATCH ?)", FtsPhrase(query.text));
+            } else {
+                add("file_name LIKE ? ESCAPE '\\'", LikePattern(query.text));
+            }
+        }
+
+        if (query.minDurationSec)   add("duration_sec >= ?", *query.minDurationSec);
+        if (query.maxDurationSec)   add("duration_sec <= ?", *query.maxDurationSec);
+        if (query.minWidth)         add("resolution_width >= ?", static_cast<int64_t>(*query.minWidth));
+        if (query.minHeight)        add("resolution_height >= ?", static_cast<int64_t>(*query.minHeight));
+        if (query.recordedAfterMs)  add("COALESCE(recording_time_ms, 0) >= ?", static_cast<int64_t>(*query.recordedAfterMs));
+        if (query.recordedBeforeMs) add("COALESCE(recording_time_ms, 0) < ?", static_cast<int64_t>(*query.recordedBeforeMs));
+        if (query.favoritesOnly)    clauses.emplace_back("is_favorite = 1");
+
+        for (size_t i = 0; i < clauses.size(); i++) {
+            filter.where += (i == 0 ? " WHERE " : " AND ") + clauses[i];
+        }
+        return filter;
+    }
+
+    const char* SortExpression(const VideoQuery::SortKey key) {
+        switch (key) {
+            case VideoQuery::SortKey::RecordingTime: return "COALESCE(recording_time_ms, 0)";
+            case VideoQuery::SortKey::Name:          return "file_name COLLATE NOCASE";
+            case VideoQuery::SortKey::Duration:      return "duration_sec";
+            case VideoQuery::SortKey::FileSize:      return "file_size";
+            case VideoQuery::SortKey::Resolution:    return "resolution_width * resolution_height";
+        }
+        return "COALESCE(recording_time_ms, 0)";
+    }
+
+    // Returns the next free placeholder index
+    int BindValues(sqlite3_stmt* stmt, const std::vector<QueryValue>& values) {
+        int index = 1;
+        for (const auto& value : values) {
+            std::visit([&]<typename T>(const T& v) {
+                if constexpr (std::is_same_v<T, int64_t>)     sqlite3_bind_int64(stmt, index, v);
+                else if constexpr (std::is_same_v<T, double>) sqlite3_bind_double(stmt, index, v);
+                else sqlite3_bind_text(stmt, index, v.c_str(), -1, SQLITE_STATIC);
+            }, value);
+            index++;
+        }
+        return index;
+    }
+}
+
 VideoDatabase::VideoDatabase(const std::string &dbPath) : db(nullptr), running(true) {
 
     try {
@@ -33,14 +236,40 @@ VideoDatabase::VideoDatabase(const std::string &dbPath) : db(nullptr), running(t
     std::cout << "[VideoDatabase] Database file exists: " << (std::filesystem::exists(dbPath) ? "YES" : "NO") << std::endl;
 
     InitializeDatabase();
-    LoadCacheFromDB();
+    MigrateSchema();
+    InitializeStats();
+    InitializeSearch();
+    PrepareStatements();
+    OpenReadConnection(dbPath);
+    // The snapshot fills lazily: by lookup, and in full on the first GetSnapshot()
+
+    // Probing is mostly I/O wait; a few threads keep the disk busy without crowding the UI
+    const size_t scanThreads = std::clamp<size_t>(std::thread::hardware_concurrency() / 4, 1, 4);
+    for (size_t i = 0; i < scanThreads; i++) {
+        scanWorkers.emplace_back(&VideoDatabase::BackgroundWorker, this);
+    }
 }
 
 VideoDatabase::~VideoDatabase() {
-    running = false;
-    if (workerThread.joinable()) {
-        workerThread.join();
+    {
+        std::lock_guard lock(scanMutex);
+        running = false;
+    }
+    scanCv.notify_all();
+    for (auto& worker : scanWorkers) {
+        if (worker.joinable()) worker.join();
     }
+
+    // Results scanned before shutdown are still worth keeping
+    WriteScanResults(pendingWrites);
+
+    // An unbalanced batch still gets committed rather than rolled back
+    if (batchOpen) {
+        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+    }
+
+    FinalizeStatements();
+    sqlite3_close(readDb);
     sqlite3_close(db);
 }
 
@@ -60,11 +289,22 @@ void VideoDatabase::InitializeDatabase() const {
             clip_end_point    REAL,
             recording_time_ms INTEGER,
             last_edit_time_ms INTEGER,
-            app_version       TEXT
+            app_version       TEXT,
+            fp_inode          INTEGER DEFAULT 0,
+            fp_size           INTEGER DEFAULT 0,
+            fp_mtime_ns       INTEGER DEFAULT 0
         );
         CREATE INDEX IF NOT EXISTS idx_file_name ON videos(file_name);
+        CREATE INDEX IF NOT EXISTS idx_duration ON videos(duration_sec);
+        CREATE INDEX IF NOT EXISTS idx_resolution ON videos(resolution_width, resolution_height);
+        DROP INDEX IF EXISTS idx_recording_time;
+        DROP INDEX IF EXISTS idx_recording_order;
+        CREATE INDEX IF NOT EXISTS idx_recording_coalesced ON videos(COALESCE(recording_time_ms, 0), file_path);
+        DROP INDEX IF EXISTS idx_favorite;
+        CREATE INDEX IF NOT EXISTS idx_favorite_recent ON videos(is_favorite, COALESCE(recording_time_ms, 0));
         PRAGMA journal_mode=WAL;
         PRAGMA synchronous=NORMAL;
+        PRAGMA recursive_triggers=ON;
         PRAGMA cache_size=10000;
     )";
 
@@ -76,234 +316,644 @@ void VideoDatabase::InitializeDatabase() const {
     }
 }
 
-VideoInfo* VideoDatabase::GetMetadata(const std::string& filePath) {
-    std::lock_guard lock(cacheMutex);
+void VideoDatabase::MigrateSchema() const {
+    std::unordered_set<std::string> existing;
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, "PRAGMA table_info(videos);", -1, &stmt, nullptr) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            existing.insert(ColumnText(stmt, 1));
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    for (const auto& [name, definition] : kAddedColumns) {
+        if (existing.contains(name)) continue;
+
+        const std::string sql = std::string("ALTER TABLE videos ADD COLUMN ") + name + " " + definition + ";";
+        char* errMsg = nullptr;
+        if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+            std::cerr << "[VideoDatabase] Migration failed (" << name << "): "
+                      << (errMsg ? errMsg : "") << std::endl;
+            sqlite3_free(errMsg);
+        } else {
+            std::cout << "[VideoDatabase] Added column " << name << std::endl;
+        }
+    }
+}
+
+void VideoDatabase::InitializeStats() const {
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, kStatsSchema, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "[VideoDatabase] InitializeStats error: " << (errMsg ? errMsg : "") << std::endl;
+        sqlite3_free(errMsg);
+        return;
+    }
+
+    bool hasRow = false;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM library_stats WHERE id = 1;", -1, &stmt, nullptr) == SQLITE_OK) {
+        hasRow = sqlite3_step(stmt) == SQLITE_ROW;
+        sqlite3_finalize(stmt);
+    }
+    if (hasRow) return;
+
+    if (sqlite3_exec(db, kStatsReconcile, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "[VideoDatabase] Stats reconcile error: " << (errMsg ? errMsg : "") << std::endl;
+        sqlite3_free(errMsg);
+    } else {
+        std::cout << "[VideoDatabase] Library statistics rebuilt" << std::endl;
+    }
+}
+
+void VideoDatabase::InitializeSearch() {
+    bool existed = false;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM sqlite_master WHERE name = 'videos_fts';", -1, &stmt, nullptr) == SQLITE_OK) {
+        existed = sqlite3_step(stmt) == SQLITE_ROW;
+        sqlite3_finalize(stmt);
+    }
+
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, kSearchSchema, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "[VideoDatabase] Full-text search unavailable, using LIKE: "
+                  << (errMsg ? errMsg : "") << std::endl;
+        sqlite3_free(errMsg);
+        return;
+    }
+
+    // Rows written before the index existed
+    if (!existed) {
+        sqlite3_exec(db, "INSERT INTO videos_fts(videos_fts) VALUES ('rebuild');", nullptr, nullptr, nullptr);
+    }
+    ftsAvailable = true;
+}
+
+void VideoDatabase::PrepareStatements() {
+    const auto prepare = [this](const std::string& sql, sqlite3_stmt** stmt) {
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, stmt, nullptr) != SQLITE_OK) {
+            std::cerr << "[VideoDatabase] Failed to prepare \"" << sql << "\": "
+                      << sqlite3_errmsg(db) << std::endl;
+            *stmt = nullptr;
+        }
+    };
+
+    const std::string columns = kVideoColumns;
+    prepare("INSERT OR REPLACE INTO videos (" + columns + ") VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);", &insertStmt);
+    prepare("SELECT " + columns + " FROM videos WHERE file_path = ?;", &selectStmt);
+    prepare("DELETE FROM videos WHERE file_path = ?;", &deleteStmt);
+}
+
+void VideoDatabase::OpenReadConnection(const std::string& dbPath) {
+    // Optional: without it, queries share the main connection as before
+    if (sqlite3_open_v2(dbPath.c_str(), &readDb, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+        std::cerr << "[VideoDatabase] Read connection unavailable, sharing the main one: "
+                  << sqlite3_errmsg(readDb) << std::endl;
+        sqlite3_close(readDb);
+        readDb = nullptr;
+        return;
+    }
+
+    // WAL readers don't wait on writers, only on a checkpoint resetting the log
+    sqlite3_busy_timeout(readDb, kReadBusyTimeoutMs);
+}
+
+void VideoDatabase::FinalizeStatements() {
+    sqlite3_finalize(insertStmt);
+    sqlite3_finalize(selectStmt);
+    sqlite3_finalize(deleteStmt);
+    insertStmt = selectStmt = deleteStmt = nullptr;
+
+    for (sqlite3_stmt* stmt : queryStmts | std::views::values) sqlite3_finalize(stmt);
+    queryStmts.clear();
+}
+
+std::shared_ptr<const LibrarySnapshot> VideoDatabase::GetSnapshot() {
+    std::call_once(fullLoad, [this] { LoadCacheFromDB(); });
+    return snapshot.load();
+}
 
-    const auto it = memoryCache.find(filePath);
-    if (it != memoryCache.end()) {
-        return &it->second;
+std::shared_ptr<const VideoInfo> VideoDatabase::GetMetadata(const std::string& filePath) {
+    // Whatever is cached so far; a miss is one primary-key lookup, not a full load
+    if (auto video = snapshot.load()->Find(filePath)) {
+        return video;
     }
 
     if (VideoInfo info; LoadFromDB(filePath, info)) {
-        memoryCache[filePath] = info;
-        return &memoryCache[filePath];
+        Publish({&info, 1});
+        return snapshot.load()->Find(filePath);
     }
 
     return nullptr;
 }
 
 void VideoDatabase::QueueForScanning(const std::string& filePath) {
-    std::lock_guard lock(cacheMutex);
-    scanQueue.push(filePath);
+    // Visible immediately with what the filesystem knows; the scan fills in the rest
+    if (!VideoExists(filePath)) {
+        VideoInfo info;
+        info.filePath       = filePath;
+        info.filePathString = filePath;
+        info.name           = fs::path(filePath).filename().string();
+
+        std::error_code ec;
+        const auto size = fs::file_size(filePath, ec);
+        info.fileSize = ec ? 0 : static_cast<int64_t>(size);
+        info.fingerprint = FileFingerprint::Read(filePath).value_or(FileFingerprint{});
+
+        SaveMetadata(info);
+    }
+
+    {
+        std::lock_guard lock(scanMutex);
+        if (!queuedPaths.insert(filePath).second) return;
+        scanQueue.push(filePath);
+        scansQueued++;
+    }
+    scanCv.notify_one();
+}
+
+void VideoDatabase::SetScanProgressCallback(ScanProgress callback) {
+    std::lock_guard lock(scanMutex);
+    scanProgress = std::move(callback);
 }
 
+// Writes reach SQLite before the snapshot, so a full load running meanwhile
+// either reads the row or is published over by it (see LoadCacheFromDB)
 void VideoDatabase::SaveMetadata(const VideoInfo& videoInfo) {
-    std::cout << "[VideoDatabase] " << videoInfo.filePathString << std::endl;
+    SaveToDB(videoInfo);
+    Publish({&videoInfo, 1});
+}
 
-    {
-        std::lock_guard<std::mutex> lock(cacheMutex);
-        std::cout << "  Mutex locked" << std::endl;
+void VideoDatabase::SaveMetadataBatch(const std::span<const VideoInfo> videos) {
+    if (videos.empty()) return;
 
-        memoryCache[videoInfo.filePathString] = videoInfo;
-        std::cout << "  Added to memory cache (size: " << memoryCache.size() << ")" << std::endl;
+    BeginBatch();
+    for (const auto& info : videos) {
+        SaveToDB(info);
     }
-    std::cout << "  Mutex unlocked" << std::endl;
+    CommitBatch();
 
-    std::cout << "  Calling SaveToDB..." << std::endl;
-    SaveToDB(videoInfo);
-    std::cout << "  SaveToDB completed" << std::endl;
+    Publish(videos);
 
-    std::cout << "SaveMetadata END" << std::endl;
+    std::cout << "[VideoDatabase] Saved " << videos.size() << " videos in one transaction" << std::endl;
 }
 
-void VideoDatabase::DeleteMetadata(const std::string& filePath) {
-    std::cout << "[VideoDatabase] " << filePath << std::endl;
+void VideoDatabase::BeginBatch() {
+    // Released by the matching CommitBatch; another thread's batch or write
+    // finishes first
+    batchMutex.lock();
+
+    std::lock_guard lock(dbMutex);
+    if (batchDepth++ > 0) return;
 
+    // IMMEDIATE takes the write lock up front instead of failing on first write
+    char* errMsg = nullptr;
+    batchOpen = sqlite3_exec(db, "BEGIN IMMEDIATE;", nullptr, nullptr, &errMsg) == SQLITE_OK;
+    if (!batchOpen) {
+        std::cerr << "[VideoDatabase] BeginBatch failed: " << (errMsg ? errMsg : "") << std::endl;
+        sqlite3_free(errMsg);   // writes fall back to autocommit
+    }
+}
+
+void VideoDatabase::CommitBatch() {
+    {
+        std::lock_guard lock(dbMutex);
+        if (--batchDepth == 0 && batchOpen) {
+            batchOpen = false;
+
+            char* errMsg = nullptr;
+            if (sqlite3_exec(db, "COMMIT;", nullptr, nullptr, &errMsg) != SQLITE_OK) {
+                std::cerr << "[VideoDatabase] CommitBatch failed: " << (errMsg ? errMsg : "") << std::endl;
+                sqlite3_free(errMsg);
+            }
+        }
+    }
+    batchMutex.unlock();
+}
+
+void VideoDatabase::DeleteMetadata(const std::string& filePath) {
     {
-        std::lock_guard lock(cacheMutex);
-        memoryCache.erase(filePath);
-        std::cout << "  Removed from memory cache" << std::endl;
+        std::lock_guard batchLock(batchMutex);
+        std::lock_guard lock(dbMutex);
+        if (deleteStmt) {
+            sqlite3_bind_text(deleteStmt, 1, filePath.c_str(), -1, SQLITE_STATIC);
+            if (sqlite3_step(deleteStmt) != SQLITE_DONE) {
+                std::cerr << "[VideoDatabase] DeleteMetadata failed for " << filePath
+                          << ": " << sqlite3_errmsg(db) << std::endl;
+            }
+            sqlite3_reset(deleteStmt);
+            sqlite3_clear_bindings(deleteStmt);
+        }
     }
 
-    sqlite3_stmt* stmt;
+    Publish({}, {&filePath, 1});
+}
 
-    if (const auto deleteSQL = "DELETE FROM videos WHERE file_path = ?;"; sqlite3_prepare_v2(db, deleteSQL, -1, &stmt, nullptr) == SQLITE_OK) {
-        sqlite3_bind_text(stmt, 1, filePath.c_str(), -1, SQLITE_STATIC);
+VideoDatabase::Totals VideoDatabase::GetTotals() {
+    Totals totals;
 
-        if (sqlite3_step(stmt) == SQLITE_DONE) {
-            std::cout << "  Removed from database" << std::endl;
-        } else {
-            std::cout << "  Database deletion failed: " << sqlite3_errmsg(db) << std::endl;
-        }
+    std::lock_guard lock(ReadMutex());
+    sqlite3_stmt* stmt = PrepareCached("SELECT video_count, total_duration_sec, total_size_bytes, "
+                                       "with_thumbnail, with_metadata FROM library_stats WHERE id = 1;");
+    if (!stmt) return totals;
 
-        sqlite3_finalize(stmt);
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        totals.videoCount           = static_cast<size_t>(std::max<int64_t>(0, sqlite3_column_int64(stmt, 0)));
+        totals.durationSec          = sqlite3_column_double(stmt, 1);
+        totals.sizeBytes            = sqlite3_column_int64(stmt, 2);
+        totals.withThumbnail        = static_cast<size_t>(std::max<int64_t>(0, sqlite3_column_int64(stmt, 3)));
+        totals.withEmbeddedMetadata = static_cast<size_t>(std::max<int64_t>(0, sqlite3_column_int64(stmt, 4)));
     }
+    sqlite3_reset(stmt);
+    return totals;
 }
 
-std::vector<VideoInfo> VideoDatabase::GetAllVideos() {
-    std::lock_guard lock(cacheMutex);
+std::unordered_map<std::string, FileFingerprint> VideoDatabase::GetFingerprints() {
+    std::unordered_map<std::string, FileFingerprint> fingerprints;
 
-    std::vector<VideoInfo> result;
-    result.reserve(memoryCache.size());
+    std::lock_guard lock(ReadMutex());
+    sqlite3_stmt* stmt = PrepareCached("SELECT file_path, fp_inode, fp_size, fp_mtime_ns FROM videos;");
+    if (!stmt) return fingerprints;
 
-    for (const auto &val: memoryCache | std::views::values) {
-        result.push_back(val);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        FileFingerprint fp;
+        fp.inode   = static_cast<uint64_t>(sqlite3_column_int64(stmt, 1));
+        fp.size    = sqlite3_column_int64(stmt, 2);
+        fp.mtimeNs = sqlite3_column_int64(stmt, 3);
+        fingerprints.emplace(ColumnText(stmt, 0), fp);
     }
-    return result;
+    sqlite3_reset(stmt);
+    return fingerprints;
 }
 
-std::vector<VideoInfo> VideoDatabase::SearchByName(const std::string& query) {
-    std::lock_guard lock(cacheMutex);
+sqlite3_stmt* VideoDatabase::PrepareCached(const std::string& sql) {
+    if (const auto it = queryStmts.find(sql); it != queryStmts.end()) return it->second;
+
+    sqlite3* connection = readDb ? readDb : db;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(connection, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "[VideoDatabase] Failed to prepare \"" << sql << "\": "
+                  << sqlite3_errmsg(connection) << std::endl;
+        return nullptr;
+    }
+    queryStmts.emplace(sql, stmt);
+    return stmt;
+}
 
+std::vector<VideoInfo> VideoDatabase::Query(const VideoQuery& query) {
     std::vector<VideoInfo> results;
-    for (const auto &val: memoryCache | std::views::values) {
-        if (val.name.find(query) != std::string::npos) {
-            results.push_back(val);
-        }
+    const QueryFilter filter = BuildFilter(query, ftsAvailable);
+
+    // file_path breaks ties so pages don't overlap
+    const std::string sql = std::string("SELECT ") + kVideoColumns + " FROM videos" + filter.where +
+                            " ORDER BY " + SortExpression(query.sortBy) + (query.descending ? " DESC" : " ASC") +
+                            ", file_path LIMIT ? OFFSET ?;";
+
+    std::lock_guard lock(ReadMutex());
+    sqlite3_stmt* stmt = PrepareCached(sql);
+    if (!stmt) return results;
+
+    const int next = BindValues(stmt, filter.values);
+    sqlite3_bind_int64(stmt, next,     query.limit == 0 ? -1 : static_cast<int64_t>(query.limit));
+    sqlite3_bind_int64(stmt, next + 1, static_cast<int64_t>(query.offset));
+
+    if (query.limit > 0) results.reserve(query.limit);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        VideoInfo info;
+        ReadRow(stmt, info);
+        results.push_back(std::move(info));
     }
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
     return results;
 }
 
+size_t VideoDatabase::Count(const VideoQuery& query) {
+    const QueryFilter filter = BuildFilter(query, ftsAvailable);
+    const std::string sql = "SELECT COUNT(*) FROM videos" + filter.where + ";";
+
+    std::lock_guard lock(ReadMutex());
+    sqlite3_stmt* stmt = PrepareCached(sql);
+    if (!stmt) return 0;
+
+    BindValues(stmt, filter.values);
+    const size_t count = sqlite3_step(stmt) == SQLITE_ROW ? static_cast<size_t>(sqlite3_column_int64(stmt, 0)) : 0;
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    return count;
+}
+
+std::vector<VideoInfo> VideoDatabase::SearchByName(const std::string& query) {
+    VideoQuery byName;
+    byName.text       = query;
+    byName.sortBy     = VideoQuery::SortKey::Name;
+    byName.descending = false;
+    return Query(byName);
+}
+
+std::vector<VideoInfo> VideoDatabase::GetGridPage(const std::optional<VideoPageCursor>& after, const size_t limit) {
+    std::vector<VideoInfo> page;
+    if (limit == 0) return page;
+
+    // Same order both ways, so idx_recording_coalesced serves the scan and the
+    // bound on its first column seeks straight to where the last page stopped
+    // (SQLite won't seek an expression index on a row-value comparison).
+    // Rows without a recording time page as 0, as ReadGridRow reads them; a
+    // bare NULL would fail the comparison and drop them after page one.
+    const std::string sql = std::string("SELECT ") + kGridColumns + " FROM videos" +
+                            (after ? " WHERE COALESCE(recording_time_ms, 0) <= ?1"
+                                     " AND (COALESCE(recording_time_ms, 0) < ?1 OR file_path < ?2)" : "") +
+                            " ORDER BY COALESCE(recording_time_ms, 0) DESC, file_path DESC LIMIT ?3;";
+
+    std::lock_guard lock(ReadMutex());
+    sqlite3_stmt* stmt = PrepareCached(sql);
+    if (!stmt) return page;
+
+    if (after) {
+        sqlite3_bind_int64(stmt, 1, after->recordingTimeMs);
+        sqlite3_bind_text(stmt, 2, after->filePath.c_str(), -1, SQLITE_STATIC);
+    }
+    sqlite3_bind_int64(stmt, 3, static_cast<int64_t>(limit));
+
+    page.reserve(limit);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        VideoInfo info;
+        ReadGridRow(stmt, info);
+        page.push_back(std::move(info));
+    }
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    return page;
+}
+
 bool VideoDatabase::IsScanning() const {
-    return !scanQueue.empty();
+    std::lock_guard lock(scanMutex);
+    return !scanQueue.empty() || activeScans > 0;
 }
 
 bool VideoDatabase::VideoExists(const std::string& filePath) {
-    std::lock_guard lock(cacheMutex);
-    return memoryCache.contains(filePath);
+    return GetMetadata(filePath) != nullptr;
 }
 
 size_t VideoDatabase::GetQueueSize() const {
+    std::lock_guard lock(scanMutex);
     return scanQueue.size();
 }
 
 void VideoDatabase::ClearCache() {
-    std::lock_guard lock(cacheMutex);
-    memoryCache.clear();
+    LoadCacheFromDB();
 }
 
-void VideoDatabase::LoadCacheFromDB() {
-    sqlite3_stmt* stmt;
+void VideoDatabase::ReadRow(sqlite3_stmt* stmt, VideoInfo& info) {
+    info.filePathString   = ColumnText(stmt, 0);
+    info.filePath         = info.filePathString;
+    info.name             = ColumnText(stmt, 1);
+    info.fileSize         = sqlite3_column_int64(stmt, 2);
 
-    if (sqlite3_prepare_v2(db, "SELECT * FROM videos;", -1, &stmt, nullptr) == SQLITE_OK) {
-        while (sqlite3_step(stmt) == SQLITE_ROW) {
-            VideoInfo info;
+    info.durationSec      = sqlite3_column_double(stmt, 3);
+    info.frameRate        = sqlite3_column_int(stmt, 4);
+    info.resolutionWidth  = sqlite3_column_int(stmt, 5);
+    info.resolutionHeight = sqlite3_column_int(stmt, 6);
+
+    info.thumbnailPath    = ColumnText(stmt, 7);
+    info.isFavorite       = sqlite3_column_int(stmt, 8) > 0;
+
+    info.clipStartPoint   = sqlite3_column_double(stmt, 9);
+    info.clipEndPoint     = sqlite3_column_double(stmt, 10);
+    info.recordingTimeMs  = sqlite3_column_int64(stmt, 11);
+    info.lastEditTimeMs   = sqlite3_column_int64(stmt, 12);
 
-            info.filePathString   = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
-            info.filePath         = info.filePathString;
-            info.name             = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-            info.fileSize         = sqlite3_column_int64(stmt, 2);
+    info.appVersion       = ColumnText(stmt, 13);
 
-            info.durationSec      = sqlite3_column_double(stmt, 3);
-            info.frameRate        = sqlite3_column_int(stmt, 4);
-            info.resolutionWidth  = sqlite3_column_int(stmt, 5);
-            info.resolutionHeight = sqlite3_column_int(stmt, 6);
+    info.fingerprint.inode   = static_cast<uint64_t>(sqlite3_column_int64(stmt, 14));
+    info.fingerprint.size    = sqlite3_column_int64(stmt, 15);
+    info.fingerprint.mtimeNs = sqlite3_column_int64(stmt, 16);
+}
 
-            info.thumbnailPath    = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 7));
-            info.isFavorite       = sqlite3_column_int(stmt, 8) > 0;
+// Columns in kGridColumns order
+void VideoDatabase::ReadGridRow(sqlite3_stmt* stmt, VideoInfo& info) {
+    info.filePathString   = ColumnText(stmt, 0);
+    info.filePath         = info.filePathString;
+    info.name             = ColumnText(stmt, 1);
+    info.fileSize         = sqlite3_column_int64(stmt, 2);
+    info.durationSec      = sqlite3_column_double(stmt, 3);
+    info.resolutionWidth  = sqlite3_column_int(stmt, 4);
+    info.resolutionHeight = sqlite3_column_int(stmt, 5);
+    info.thumbnailPath    = ColumnText(stmt, 6);
+    info.isFavorite       = sqlite3_column_int(stmt, 7) > 0;
+    info.recordingTimeMs  = sqlite3_column_int64(stmt, 8);
+}
 
-            info.clipStartPoint   = sqlite3_column_double(stmt, 9);
-            info.clipEndPoint     = sqlite3_column_double(stmt, 10);
-            info.recordingTimeMs  = sqlite3_column_int64(stmt, 11);
-            info.lastEditTimeMs   = sqlite3_column_int64(stmt, 12);
+void VideoDatabase::LoadCacheFromDB() {
+    std::vector<LibrarySnapshot::VideoPtr> videos;
 
-            info.appVersion       = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 13));
+    // Held across the read and the store: writers commit to SQLite first and
+    // publish second, so a write this read misses waits here and lands on top
+    std::lock_guard publishLock(publishMutex);
 
-            memoryCache[info.filePathString] = info;
+    // The primary key index hands rows back in path order, as the snapshot wants them
+    const std::string sql = std::string("SELECT ") + kVideoColumns + " FROM videos ORDER BY file_path;";
+    {
+        std::lock_guard lock(dbMutex);
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                auto info = std::make_shared<VideoInfo>();
+                ReadRow(stmt, *info);
+                videos.push_back(std::move(info));
+            }
+            sqlite3_finalize(stmt);
         }
-        sqlite3_finalize(stmt);
     }
+
+    // SQLite's BINARY collation is byte order, the same as std::string's
+    const uint64_t version = snapshot.load()->GetVersion() + 1;
+    snapshot.store(std::make_shared<const LibrarySnapshot>(version, std::move(videos)));
 }
 
-bool VideoDatabase::LoadFromDB(const std::string& filePath, VideoInfo& info) const {
-    sqlite3_stmt* stmt;
-    bool found = false;
+void VideoDatabase::Publish(const std::span<const VideoInfo> upserts, const std::span<const std::string> removals) {
+    using VideoPtr = LibrarySnapshot::VideoPtr;
+    const auto byPath = [](const VideoPtr& video) -> const std::string& { return video->filePathString; };
+
+    std::lock_guard lock(publishMutex);
+    const auto current = snapshot.load();
+
+    // Only the pointers are copied; untouched records are shared with the old version
+    std::vector<VideoPtr> videos = current->GetVideos();
+    std::vector<VideoPtr> added;
 
-    if (sqlite3_prepare_v2(db, "SELECT * FROM videos WHERE file_path = ?;", -1, &stmt, nullptr) == SQLITE_OK) {
-        sqlite3_bind_text(stmt, 1, filePath.c_str(), -1, SQLITE_STATIC);
+    for (const auto& info : upserts) {
+        auto video = std::make_shared<const VideoInfo>(info);
+        const auto it = LibrarySnapshot::LowerBound(videos, info.filePathString);
+        if (it != videos.cend() && (*it)->filePathString == info.filePathString) {
+            videos[it - videos.cbegin()] = std::move(video);
+        } else {
+            added.push_back(std::move(video));
+        }
+    }
 
-        if (sqlite3_step(stmt) == SQLITE_ROW) {
-            info.filePathString   = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
-            info.filePath         = info.filePathString;
-            info.name             = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-            info.fileSize         = sqlite3_column_int64(stmt, 2);
+    if (!removals.empty()) {
+        const std::unordered_set<std::string_view> gone(removals.begin(), removals.end());
+        const auto isGone = [&](const VideoPtr& video) { return gone.contains(video->filePathString); };
+        std::erase_if(videos, isGone);
+        std::erase_if(added, isGone);
+    }
 
-            info.durationSec      = sqlite3_column_double(stmt, 3);
-            info.frameRate        = sqlite3_column_int(stmt, 4);
-            info.resolutionWidth  = sqlite3_column_int(stmt, 5);
-            info.resolutionHeight = sqlite3_column_int(stmt, 6);
+    if (!added.empty()) {
+        // A path added twice in one batch keeps its last record
+        std::ranges::stable_sort(added, {}, byPath);
+        const size_t middle = videos.size();
+        for (size_t i = 0; i < added.size(); i++) {
+            if (i + 1 < added.size() && added[i]->filePathString == added[i + 1]->filePathString) continue;
+            videos.push_back(std::move(added[i]));
+        }
+        std::ranges::inplace_merge(videos, videos.begin() + static_cast<std::ptrdiff_t>(middle), {}, byPath);
+    }
 
-            info.thumbnailPath    = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 7));
-            info.isFavorite       = sqlite3_column_int(stmt, 8) > 0;
+    snapshot.store(std::make_shared<const LibrarySnapshot>(current->GetVersion() + 1, std::move(videos)));
+}
 
-            info.clipStartPoint   = sqlite3_column_double(stmt, 9);
-            info.clipEndPoint     = sqlite3_column_double(stmt, 10);
-            info.recordingTimeMs  = sqlite3_column_int64(stmt, 11);
-            info.lastEditTimeMs   = sqlite3_column_int64(stmt, 12);
+bool VideoDatabase::LoadFromDB(const std::string& filePath, VideoInfo& info) {
+    std::lock_guard lock(dbMutex);
+    if (!selectStmt) return false;
 
-            info.appVersion       = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 13));
+    sqlite3_bind_text(selectStmt, 1, filePath.c_str(), -1, SQLITE_STATIC);
 
-            found = true;
-        }
-        sqlite3_finalize(stmt);
+    const bool found = sqlite3_step(selectStmt) == SQLITE_ROW;
+    if (found) {
+        ReadRow(selectStmt, info);
     }
 
+    sqlite3_reset(selectStmt);
+    sqlite3_clear_bindings(selectStmt);
     return found;
 }
 
-void VideoDatabase::SaveToDB(const VideoInfo& info) const {
-    const auto insertSQL = R"(
-        INSERT OR REPLACE INTO videos VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?);
-    )";
+void VideoDatabase::SaveToDB(const VideoInfo& info) {
+    std::lock_guard batchLock(batchMutex);
+    std::lock_guard lock(dbMutex);
+    if (!insertStmt) return;
 
-    sqlite3_stmt* stmt;
-    if (sqlite3_prepare_v2(db, insertSQL, -1, &stmt, nullptr) == SQLITE_OK) {
-        sqlite3_bind_text(stmt, 1,  info.filePathString.c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_text(stmt, 2,  info.name.c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_int64(stmt, 3, info.fileSize);
+    sqlite3_stmt* stmt = insertStmt;
+    sqlite3_bind_text(stmt, 1,  info.filePathString.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2,  info.name.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 3, info.fileSize);
 
-        sqlite3_bind_double(stmt, 4, info.durationSec);
-        sqlite3_bind_int(stmt, 5,   info.frameRate);
-        sqlite3_bind_int(stmt, 6,   info.resolutionWidth);
-        sqlite3_bind_int(stmt, 7,   info.resolutionHeight);
+    sqlite3_bind_double(stmt, 4, info.durationSec);
+    sqlite3_bind_int(stmt, 5,   info.frameRate);
+    sqlite3_bind_int(stmt, 6,   info.resolutionWidth);
+    sqlite3_bind_int(stmt, 7,   info.resolutionHeight);
 
-        sqlite3_bind_text(stmt, 8,  info.thumbnailPath.c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_int(stmt, 9,   info.isFavorite ? 1 : 0);
+    sqlite3_bind_text(stmt, 8,  info.thumbnailPath.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 9,   info.isFavorite ? 1 : 0);
 
-        sqlite3_bind_double(stmt, 10, info.clipStartPoint);
-        sqlite3_bind_double(stmt, 11, info.clipEndPoint);
-        sqlite3_bind_int64(stmt, 12,  info.recordingTimeMs);
-        sqlite3_bind_int64(stmt, 13,  info.lastEditTimeMs);
+    sqlite3_bind_double(stmt, 10, info.clipStartPoint);
+    sqlite3_bind_double(stmt, 11, info.clipEndPoint);
+    sqlite3_bind_int64(stmt, 12,  info.recordingTimeMs);
+    sqlite3_bind_int64(stmt, 13,  info.lastEditTimeMs);
 
-        sqlite3_bind_text(stmt, 14, info.appVersion.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 14, info.appVersion.c_str(), -1, SQLITE_STATIC);
 
-        sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
-    } else {
+    sqlite3_bind_int64(stmt, 15, static_cast<sqlite3_int64>(info.fingerprint.inode));
+    sqlite3_bind_int64(stmt, 16, info.fingerprint.size);
+    sqlite3_bind_int64(stmt, 17, info.fingerprint.mtimeNs);
+
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
         std::cerr << "[VideoDatabase] SaveToDB failed: " << sqlite3_errmsg(db) << std::endl;
     }
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
 }
 
-void VideoDatabase::BackgroundWorker() const {
-    std::cout << "[VideoDatabase] BackgroundWorker DISABLED (causing deadlock)" << std::endl;
+// ─── Background scanning ─────────────────────────────────────────────────────
+
+void VideoDatabase::BackgroundWorker() {
+    std::unique_lock lock(scanMutex);
+
+    while (true) {
+        scanCv.wait(lock, [this] { return !running || !scanQueue.empty(); });
+        if (!running) return;   // unscanned files stay registered with basic info
+
+        const std::string filePath = std::move(scanQueue.front());
+        scanQueue.pop();
+        queuedPaths.erase(filePath);
+        activeScans++;
+
+        lock.unlock();
+        VideoInfo scanned = ExtractVideoMetadata(filePath);
+        lock.lock();
+
+        if (scanned.resolutionWidth > 0 || scanned.durationSec > 0.0) {
+            pendingWrites.push_back(std::move(scanned));
+        }
+        scansDone++;
+
+        // Coalesce: one transaction per full batch, and whatever is pending once
+        // nothing is left to start, so no result waits on another thread's
+        // timing. activeScans still counts this thread, so IsScanning stays
+        // true until written.
+        std::vector<VideoInfo> batch;
+        if (pendingWrites.size() >= kScanBatchSize || scanQueue.empty()) {
+            batch.swap(pendingWrites);
+        }
 
-    while (running) {
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        const ScanProgress progress = scanProgress;
+        const size_t done  = scansDone;
+        const size_t total = scansQueued;
+        // Every queued file probed: the burst is over
+        if (scanQueue.empty() && scansDone == scansQueued) {
+            scansDone = scansQueued = 0;
+        }
+
+        lock.unlock();
+        WriteScanResults(batch);
+        if (progress) progress(done, total);
+        lock.lock();
+
+        activeScans--;
     }
+}
 
-    std::cout << "[VideoDatabase] BackgroundWorker ended" << std::endl;
+void VideoDatabase::WriteScanResults(const std::vector<VideoInfo>& scanned) {
+    if (scanned.empty()) return;
+
+    // Only the probed fields change; favourites, clip points and thumbnails are kept
+    std::vector<VideoInfo> merged;
+    merged.reserve(scanned.size());
+    for (const auto& result : scanned) {
+        const auto existing = GetMetadata(result.filePathString);
+        if (!existing) continue;   // deleted while it was being scanned
+
+        VideoInfo info = *existing;
+        info.fileSize         = result.fileSize;
+        info.lastModified     = result.lastModified;
+        info.fingerprint      = result.fingerprint;
+        info.durationSec      = result.durationSec;
+        info.frameRate        = result.frameRate;
+        info.resolutionWidth  = result.resolutionWidth;
+        info.resolutionHeight = result.resolutionHeight;
+        merged.push_back(std::move(info));
+    }
 
+    SaveMetadataBatch(merged);
 }
 
 VideoInfo VideoDatabase::ExtractVideoMetadata(const std::string& filePath) {
-    VideoInfo info;
-    info.filePath = filePath;
-    info.filePathString = filePath;
-
-    const fs::path p(filePath);
-    info.name = p.filename().string();
+    const MediaProbe probe(filePath);
+    return ExtractVideoMetadata(probe);
+}
 
-    // TODO: FFmpeg extract video metadata
+VideoInfo VideoDatabase::ExtractVideoMetadata(const MediaProbe& probe) {
+    VideoInfo info;
+    probe.FillVideoInfo(info);
 
+    if (info.fileSize == 0) {
+        std::cerr << "[VideoDatabase] Cannot stat " << probe.GetPath() << std::endl;
+    } else if (!probe.IsOpen()) {
+        std::cerr << "[VideoDatabase] Cannot open " << probe.GetPath() << std::endl;
+    }
     return info;
-}
\ No newline at end of file
+}
@@ -3,11 +3,15 @@
 #include <algorithm>
 
 #include "core/library/VideoDatabase.h"
+#include "core/media/IntegrityChecker.h"
+#include "core/media/ThumbnailAtlas.h"
 #include "core/media/ThumbnailService.h"
+#include "core/media/MediaProbe.h"
 #include "core/media/MetadataEmbedder.h"
 
 #include <filesystem>
 #include <iostream>
+#include <unordered_set>
 
 namespace fs = std::filesystem;
 
@@ -26,14 +30,18 @@ namespace logs{
 }
 
 
-VideoLibrary::VideoLibrary(const ProjectPaths& paths)
-    : m_paths(paths) {
+VideoLibrary::VideoLibrary(const ProjectPaths& paths, std::shared_ptr<VideoDatabase> database)
+    : m_paths(paths), m_database(std::move(database)) {
 
     EnsureDirectoriesExist();
 
-    m_database = std::make_unique<VideoDatabase>(m_paths.dbPath.string());
+    if (!m_database) {
+        m_database = std::make_shared<VideoDatabase>(m_paths.dbPath.string());
+    }
     m_thumbnailService = std::make_unique<ThumbnailService>(m_paths.thumbFolder.string());
+    m_thumbnailAtlas = std::make_unique<ThumbnailAtlas>(m_paths.thumbFolder);
     m_metadataEmbedder = std::make_unique<MetadataEmbedder>();
+    m_integrityChecker = std::make_unique<IntegrityChecker>();
 
     logs::LogInfo("VideoLibrary initialized successfully");
 }
@@ -70,64 +78,62 @@ bool VideoLibrary::IsVideoFile(const fs::path& filePath) {
 
 
 // QUERY OPERATIONS
-std::vector<VideoInfo> VideoLibrary::GetAllVideos() const {
-    return m_database->GetAllVideos();
+std::shared_ptr<const LibrarySnapshot> VideoLibrary::GetSnapshot() const {
+    return m_database->GetSnapshot();
 }
 
-std::optional<std::reference_wrapper<const VideoInfo>> VideoLibrary::GetVideo(const std::string& filePath) const {
-    if (const auto* video = m_database->GetMetadata(filePath)) {
-        return std::cref(*video);
-    }
-    return std::nullopt;
+std::shared_ptr<const VideoInfo> VideoLibrary::GetVideo(const std::string& filePath) const {
+    return m_database->GetMetadata(filePath);
 }
 
-std::vector<VideoInfo> VideoLibrary::SearchByName(const std::string& query) const {
-    return m_database->SearchByName(query);
+std::vector<VideoInfo> VideoLibrary::Query(const VideoQuery& query) const {
+    return m_database->Query(query);
 }
 
-std::vector<VideoInfo> VideoLibrary::FilterByDuration(double minSec, double maxSec) const {
-    auto allVideos = m_database->GetAllVideos();
-    std::vector<VideoInfo> filtered;
-
-    std::ranges::copy_if(allVideos,
-                         std::back_inserter(filtered),
-                         [minSec, maxSec](const VideoInfo& video) {
-                             return video.durationSec >= minSec && video.durationSec <= maxSec;
-                         });
+size_t VideoLibrary::Count(const VideoQuery& query) const {
+    return m_database->Count(query);
+}
 
-    return filtered;
+std::vector<VideoInfo> VideoLibrary::GetGridPage(const std::optional<VideoPageCursor>& after, const size_t limit) const {
+    return m_database->GetGridPage(after, limit);
 }
 
-std::vector<VideoInfo> VideoLibrary::FilterByResolution(int minWidth, int minHeight) const {
-    auto allVideos = m_database->GetAllVideos();
-    std::vector<VideoInfo> filtered;
+std::vector<VideoInfo> VideoLibrary::SearchByName(const std::string& query) const {
+    return m_database->SearchByName(query);
+}
 
-    std::ranges::copy_if(allVideos,
-                         std::back_inserter(filtered),
-                         [minWidth, minHeight](const VideoInfo& video) {
-                             return video.resolutionWidth >= minWidth &&
-                                    video.resolutionHeight >= minHeight;
-                         });
+std::vector<VideoInfo> VideoLibrary::FilterByDuration(const double minSec, const double maxSec) const {
+    VideoQuery query;
+    query.minDurationSec = minSec;
+    query.maxDurationSec = maxSec;
+    return m_database->Query(query);
+}
 
-    return filtered;
+std::vector<VideoInfo> VideoLibrary::FilterByResolution(const int minWidth, const int minHeight) const {
+    VideoQuery query;
+    query.minWidth  = minWidth;
+    query.minHeight = minHeight;
+    return m_database->Query(query);
 }
 
 // VIDEO OPERATIONS
-VideoInfo VideoLibrary::LoadVideo(const std::string& videoPath) {
+VideoInfo VideoLibrary::LoadVideo(const std::string& videoPath, const bool generateThumbnail) {
     logs::LogInfo("Loading video: " + videoPath);
 
     try {
         // 1. Check cache first (fastest)
-        if (auto* cached = m_database->GetMetadata(videoPath)) {
+        if (const auto cached = m_database->GetMetadata(videoPath)) {
             logs::LogInfo("  Found in cache");
             return *cached;
         }
 
-        // 2. Try embedded metadata (medium speed)
+        // 2. Try embedded metadata (medium speed); the one open serves every later step
         VideoInfo info;
-        if (m_metadataEmbedder && m_metadataEmbedder->HasEmbeddedMetadata(videoPath)) {
+        MediaProbe probe(videoPath);
+
+        if (m_metadataEmbedder && m_metadataEmbedder->HasEmbeddedMetadata(probe)) {
             logs::LogInfo("  Reading embedded metadata");
-            if (m_metadataEmbedder->ReadMetadataFromVideo(videoPath, info)) {
+            if (m_metadataEmbedder->ReadMetadataFromVideo(probe, info)) {
                 m_database->SaveMetadata(info);
                 return info;
             }
@@ -135,7 +141,7 @@ VideoInfo VideoLibrary::LoadVideo(const std::string& videoPath) {
 
         // 3. Scan with FFmpeg (slowest)
         logs::LogInfo("  Scanning with FFmpeg");
-        info = ScanVideoFile(videoPath);
+        info = VideoDatabase::ExtractVideoMetadata(probe);
 
         if (info.fileSize == 0) {
             logs::LogWarning("Could not scan video file: " + videoPath);
@@ -143,16 +149,20 @@ VideoInfo VideoLibrary::LoadVideo(const std::string& videoPath) {
         }
 
         // 4. Generate thumbnail
-        if (auto thumbPath = GenerateThumbnail(videoPath)) {
-            info.thumbnailPath = thumbPath.value();
+        if (generateThumbnail) {
+            if (auto thumbPath = GenerateThumbnail(videoPath, &probe)) {
+                info.thumbnailPath = thumbPath.value();
+            }
         }
 
-        // 5. Embed metadata
-        if (m_metadataEmbedder) {
-            m_metadataEmbedder->WriteMetadataToVideo(videoPath, info);
+        // 5. Embed metadata (the probe lets go of the file first)
+        probe.Close();
+        if (m_metadataEmbedder && m_metadataEmbedder->WriteMetadataToVideo(videoPath, info)) {
+            if (info.appVersion.empty()) info.appVersion = MetadataEmbedder::DEFAULT_APP_VERSION;
         }
 
-        // 6. Save to database
+        // 6. Save to database (fingerprint taken after embedding rewrote the file)
+        info.fingerprint = FileFingerprint::Read(videoPath).value_or(FileFingerprint{});
         m_database->SaveMetadata(info);
 
         return info;
@@ -189,6 +199,59 @@ bool VideoLibrary::UpdateVideo(const VideoInfo& info, bool updateVideoFile) {
     }
 }
 
+VideoInfo VideoLibrary::RefreshVideo(const std::string& videoPath) {
+    const auto existing = GetVideo(videoPath);
+    if (!existing) {
+        return LoadVideo(videoPath, false);
+    }
+
+    VideoInfo info = *existing;
+    const VideoInfo scanned = ScanVideoFile(videoPath);
+
+    info.fileSize         = scanned.fileSize;
+    info.lastModified     = scanned.lastModified;
+    info.fingerprint      = scanned.fingerprint;
+    info.durationSec      = scanned.durationSec;
+    info.frameRate        = scanned.frameRate;
+    info.resolutionWidth  = scanned.resolutionWidth;
+    info.resolutionHeight = scanned.resolutionHeight;
+
+    // The picture may have changed as well
+    if (!info.thumbnailPath.empty()) {
+        std::error_code ec;
+        fs::remove(info.thumbnailPath, ec);
+        info.thumbnailPath.clear();
+    }
+
+    m_database->SaveMetadata(info);
+    logs::LogInfo("Refreshed changed video: " + info.name);
+    return info;
+}
+
+void VideoLibrary::RemoveMissingVideo(const std::string& videoPath) {
+    if (const auto video = GetVideo(videoPath)) {
+        if (const auto& thumbnail = video->thumbnailPath; !thumbnail.empty()) {
+            std::error_code ec;
+            fs::remove(thumbnail, ec);
+        }
+    }
+
+    DeleteVideo(videoPath, false);
+}
+
+void VideoLibrary::EnsureThumbnail(const std::string& videoPath) {
+    const auto video = GetVideo(videoPath);
+    if (!video) return;
+
+    VideoInfo info = *video;
+    if (!info.thumbnailPath.empty() && fs::exists(info.thumbnailPath)) return;
+
+    if (auto thumbPath = GenerateThumbnail(videoPath)) {
+        info.thumbnailPath = thumbPath.value();
+        m_database->SaveMetadata(info);
+    }
+}
+
 bool VideoLibrary::DeleteVideo(const std::string& filePath, const bool deleteFromDisk) {
     try {
         if (m_database) {
@@ -209,53 +272,108 @@ bool VideoLibrary::DeleteVideo(const std::string& filePath, const bool deleteFro
     }
 }
 
-void VideoLibrary::RegenerateMissingThumbnails() {
+void VideoLibrary::RegenerateMissingThumbnails(const ThumbnailProgress& onProgress) {
     logs::LogInfo("Regenerating missing thumbnails...");
 
+    if (!m_thumbnailService) {
+        logs::LogWarning("ThumbnailService not available");
+        return;
+    }
+
     try {
-        auto allVideos = m_database->GetAllVideos();
-        size_t regenerated = 0;
-
-        for (const auto& video : allVideos) {
-            if (video.thumbnailPath.empty() || !fs::exists(video.thumbnailPath)) {
-                if (auto thumbPath = GenerateThumbnail(video.filePathString)) {
-                    VideoInfo updated = video;
-                    updated.thumbnailPath = thumbPath.value();
-                    m_database->SaveMetadata(updated);
-                    regenerated++;
-                }
+        std::vector<VideoInfo> missing;
+        for (const auto& video : *m_database->GetSnapshot()) {
+            if (video->thumbnailPath.empty() || !fs::exists(video->thumbnailPath)) {
+                missing.push_back(*video);
             }
         }
+        if (missing.empty()) return;
+
+        std::vector<std::string> paths;
+        paths.reserve(missing.size());
+        for (const auto& video : missing) paths.push_back(video.filePathString);
+
+        // Runs on the worker pool; results are collected in submission order
+        auto jobs = m_thumbnailService->SubmitBatch(paths, ThumbnailStrategy::KEYFRAME_NEAR_1SEC, 320, 180);
+        std::vector<VideoInfo> regenerated;
+
+        for (size_t i = 0; i < jobs.size(); i++) {
+            std::string thumbPath;
+            try {
+                thumbPath = jobs[i].thumbnailPath.get();
+            } catch (const std::exception& e) {
+                logs::LogError("Thumbnail job failed: " + std::string(e.what()));
+            }
 
-        logs::LogInfo("Regenerated " + std::to_string(regenerated) + " thumbnails");
+            if (!thumbPath.empty()) {
+                missing[i].thumbnailPath = thumbPath;
+                regenerated.push_back(std::move(missing[i]));
+            }
+
+            if (onProgress) onProgress(i + 1, jobs.size());
+        }
+
+        m_database->SaveMetadataBatch(regenerated);
+        logs::LogInfo("Regenerated " + std::to_string(regenerated.size()) + " thumbnails");
 
     } catch (const std::exception& e) {
         logs::LogError("Failed to regenerate thumbnails: " + std::string(e.what()));
     }
 }
 
+void VideoLibrary::PackThumbnailAtlas() const {
+    if (!m_thumbnailAtlas) return;
+
+    try {
+        std::vector<std::string> thumbnails;
+        for (const auto& video : *m_database->GetSnapshot()) {
+            if (!video->thumbnailPath.empty()) thumbnails.push_back(video->thumbnailPath);
+        }
+
+        if (!m_thumbnailAtlas->Sync(thumbnails)) {
+            logs::LogWarning("Thumbnail atlas is incomplete; missing tiles load individually");
+        }
+    } catch (const std::exception& e) {
+        logs::LogError("Failed to pack thumbnail atlas: " + std::string(e.what()));
+    }
+}
+
+void VideoLibrary::PackThumbnail(const std::string& videoPath) const {
+    if (!m_thumbnailAtlas) return;
+
+    const auto video = GetVideo(videoPath);
+    if (!video || video->thumbnailPath.empty()) return;
+
+    try {
+        if (!m_thumbnailAtlas->Update(video->thumbnailPath)) {
+            logs::LogWarning("Thumbnail not packed; it loads individually: " + video->thumbnailPath);
+        }
+    } catch (const std::exception& e) {
+        logs::LogError("Failed to pack thumbnail: " + std::string(e.what()));
+    }
+}
 
 void VideoLibrary::SyncWithVideoFiles() const {
     logs::LogInfo("Syncing with video files...");
 
     try {
-        const auto allVideos = m_database->GetAllVideos();
-        size_t synced = 0;
+        const auto snapshot = m_database->GetSnapshot();
+        std::vector<VideoInfo> synced;
 
-        for (const auto& video : allVideos) {
+        for (const auto& video : *snapshot) {
             if (!m_metadataEmbedder) {
                 continue;
             }
 
-            if (VideoInfo videoFileData; m_metadataEmbedder->ReadMetadataFromVideo(video.filePathString, videoFileData)) {
-                if (videoFileData.lastEditTimeMs > video.lastEditTimeMs) {
-                    m_database->SaveMetadata(videoFileData);
-                    synced++;
+            if (VideoInfo videoFileData; m_metadataEmbedder->ReadMetadataFromVideo(video->filePathString, videoFileData)) {
+                if (videoFileData.lastEditTimeMs > video->lastEditTimeMs) {
+                    synced.push_back(std::move(videoFileData));
                 }
             }
         }
 
-        logs::LogInfo("Synced " + std::to_string(synced) + " videos");
+        m_database->SaveMetadataBatch(synced);
+        logs::LogInfo("Synced " + std::to_string(synced.size()) + " videos");
 
     } catch (const std::exception& e) {
         logs::LogError("Failed to sync with video files: " + std::string(e.what()));
@@ -266,42 +384,61 @@ void VideoLibrary::CleanupOrphanedRecords() {
     logs::LogInfo("Cleaning up orphaned records...");
 
     try {
-        const auto allVideos = m_database->GetAllVideos();
-        size_t removedCount = 0;
+        const auto snapshot = m_database->GetSnapshot();
+
+        // Only rows whose file changed since it was probed, or that never got a
+        // duration, go through the checker; the rest were readable back then
+        std::vector<const VideoInfo*> suspects;
+        std::vector<std::string> suspectPaths;
+        std::vector<std::pair<const VideoInfo*, std::string>> toRemove;
+        std::unordered_set<const VideoInfo*> deleteFromDisk;
+
+        for (const auto& video : *snapshot) {
+            const auto current = FileFingerprint::Read(video->filePathString);
+            if (!current) {
+                toRemove.emplace_back(video.get(), "File deleted");
+                continue;
+            }
+            if (video->fingerprint == *current && video->durationSec > 0.0) continue;
 
-        for (const auto& video : allVideos) {
-            bool shouldRemove = false;
+            suspects.push_back(video.get());
+            suspectPaths.push_back(video->filePathString);
+        }
 
-            if (!fs::exists(video.filePath)) {
-                shouldRemove = true;
-                logs::LogInfo("  File deleted: " + video.name);
-            }
-            else if (IsVideoCorrupted(video.filePathString)) {
-                shouldRemove = true;
-                logs::LogInfo("  Corrupted video detected: " + video.name);
-            }
+        const auto verdicts = m_integrityChecker->CheckAll(suspectPaths);
+        for (size_t i = 0; i < suspects.size(); i++) {
+            if (!IntegrityChecker::IsCorrupted(verdicts[i])) continue;
 
-            if (shouldRemove) {
-                if (!video.thumbnailPath.empty() && fs::exists(video.thumbnailPath)) {
-                    try {
-                        fs::remove(video.thumbnailPath);
-                        logs::LogInfo("    Deleted thumbnail");
-                    } catch (...) {}
-                }
+            // A suspect file stays on disk; only its record goes
+            const bool unrecoverable = IntegrityChecker::IsUnrecoverable(verdicts[i]);
+            if (unrecoverable) deleteFromDisk.insert(suspects[i]);
+            toRemove.emplace_back(suspects[i],
+                                  std::string(unrecoverable ? "Corrupted video detected (" : "Suspect video, file kept (") +
+                                  IntegrityChecker::ToString(verdicts[i]) + ")");
+        }
 
-                if (fs::exists(video.filePath)) {
-                    try {
-                        fs::remove(video.filePath);
-                        logs::LogInfo("    Deleted corrupted file");
-                    } catch (...) {}
-                }
+        for (const auto& [video, reason] : toRemove) {
+            logs::LogInfo("  " + reason + ": " + video->name);
 
-                DeleteVideo(video.filePathString, false);
-                removedCount++;
+            if (!video->thumbnailPath.empty() && fs::exists(video->thumbnailPath)) {
+                try {
+                    fs::remove(video->thumbnailPath);
+                    logs::LogInfo("    Deleted thumbnail");
+                } catch (...) {}
             }
+
+            if (deleteFromDisk.contains(video) && fs::exists(video->filePath)) {
+                try {
+                    fs::remove(video->filePath);
+                    logs::LogInfo("    Deleted corrupted file");
+                } catch (...) {}
+            }
+
+            DeleteVideo(video->filePathString, false);
         }
 
-        logs::LogInfo("Cleanup complete: Removed " + std::to_string(removedCount) + " records");
+        logs::LogInfo("Cleanup complete: Checked " + std::to_string(suspects.size()) +
+                      ", removed " + std::to_string(toRemove.size()) + " records");
 
     } catch (const std::exception& e) {
         logs::LogError("Failed to cleanup: " + std::string(e.what()));
@@ -309,95 +446,49 @@ void VideoLibrary::CleanupOrphanedRecords() {
 }
 
 bool VideoLibrary::IsVideoCorrupted(const std::string& videoPath) {
-    const std::string cmd = "ffprobe -v error -show_entries format=duration -of default=noprint_wrappers=1:nokey=1 \""
-                     + videoPath + "\" 2>&1";
-
-    FILE* pipe = popen(cmd.c_str(), "r");
-    if (!pipe) return true;
-
-    char buffer[128];
-    std::string result;
-    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-        result += buffer;
-    }
-    pclose(pipe);
-
-    return result.find("moov atom not found") != std::string::npos ||
-           result.empty() ||
-           result == "N/A\n";
+    return IntegrityChecker::IsCorrupted(IntegrityChecker::Inspect(videoPath));
 }
 
 VideoLibrary::Statistics VideoLibrary::GetStatistics() const {
     Statistics stats;
 
-    try {
-        const auto& allVideos = m_database->GetAllVideos();
-        stats.totalVideos = allVideos.size();
-
-        for (const auto& video : allVideos) {
-            stats.totalDurationSec += video.durationSec;
-
-            // Avoid disk I/O if size is cached
-            if (video.fileSize > 0) {
-                stats.totalSizeBytes += video.fileSize;
-            } else if (fs::exists(video.filePath)) {
-                stats.totalSizeBytes += fs::file_size(video.filePath);
-            }
-
-            if (!video.thumbnailPath.empty() && fs::exists(video.thumbnailPath)) {
-                stats.videosWithThumbnails++;
-            }
-
-            // Avoid service call if metadata already known
-            if (m_metadataEmbedder && m_metadataEmbedder->HasEmbeddedMetadata(video.filePathString)) {
-                stats.videosWithEmbeddedMetadata++;
-            }
-        }
-
-    } catch (const std::exception& e) {
-        logs::LogError("Failed to get statistics: " + std::string(e.what()));
-    }
+    // Maintained by the database as rows change: no copies, no disk I/O. A
+    // thumbnail counts once it is recorded; app_version once it was read from
+    // or written to the file.
+    const auto totals = m_database->GetTotals();
+    stats.totalVideos                = totals.videoCount;
+    stats.totalDurationSec           = totals.durationSec;
+    stats.totalSizeBytes             = static_cast<size_t>(std::max<int64_t>(0, totals.sizeBytes));
+    stats.videosWithThumbnails       = totals.withThumbnail;
+    stats.videosWithEmbeddedMetadata = totals.withEmbeddedMetadata;
 
     return stats;
 }
 
 VideoInfo VideoLibrary::ScanVideoFile(const std::string& videoPath) {
-    VideoInfo info;
-    info.filePath = videoPath;
-    info.filePathString = videoPath;
-    info.name = fs::path(videoPath).filename().string();
-
-    try {
-        if (fs::exists(videoPath)) {
-            info.fileSize = fs::file_size(videoPath);
-        } else {
-            logs::LogWarning("File does not exist: " + videoPath);
-            return info;
-        }
-
-        // TODO: Move FFmpeg scanning logic here
-        // For now, return basic info with file size
-
-    } catch (const std::exception& e) {
-        logs::LogWarning("Failed to scan video file: " + std::string(e.what()));
+    if (!fs::exists(videoPath)) {
+        logs::LogWarning("File does not exist: " + videoPath);
+        VideoInfo info;
+        info.filePath = videoPath;
+        info.filePathString = videoPath;
+        info.name = fs::path(videoPath).filename().string();
+        return info;
     }
 
-    return info;
+    return VideoDatabase::ExtractVideoMetadata(videoPath);
 }
 
-std::optional<std::string> VideoLibrary::GenerateThumbnail(const std::string& videoPath) const {
+std::optional<std::string> VideoLibrary::GenerateThumbnail(const std::string& videoPath,
+                                                           const MediaProbe* probe) const {
     if (!m_thumbnailService) {
         logs::LogWarning("ThumbnailService not available");
         return std::nullopt;
     }
 
     try {
-        std::string thumbPath = m_thumbnailService->GenerateThumbnail(
-            videoPath,
-            ThumbnailStrategy::FRAME_AT_1SEC,
-            320,
-            180
-        );
+        std::string thumbPath = probe
+            ? m_thumbnailService->GenerateThumbnail(*probe, ThumbnailStrategy::KEYFRAME_NEAR_1SEC, 320, 180)
+            : m_thumbnailService->GenerateThumbnail(videoPath, ThumbnailStrategy::KEYFRAME_NEAR_1SEC, 320, 180);
 
         if (!thumbPath.empty() && fs::exists(thumbPath)) {
             return thumbPath;
@@ -0,0 +1,623 @@
+#include "core/media/ContainerPatcher.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+using Bytes = std::vector<uint8_t>;
+
+// ─── File & Byte Helpers ─────────────────────────────────────────────────────
+
+namespace {
+    struct FileHandle {
+        int fd = -1;
+        explicit FileHandle(const std::string& path) : fd(open(path.c_str(), O_RDWR | O_CLOEXEC)) {}
+        ~FileHandle() { if (fd >= 0) close(fd); }
+        FileHandle(const FileHandle&) = delete;
+        FileHandle& operator=(const FileHandle&) = delete;
+    };
+
+    bool ReadAt(const int fd, uint64_t offset, void* dst, size_t length) {
+        auto* out = static_cast<uint8_t*>(dst);
+        while (length > 0) {
+            const ssize_t n = pread(fd, out, length, static_cast<off_t>(offset));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            out += n; offset += n; length -= n;
+        }
+        return true;
+    }
+
+    bool WriteAt(const int fd, uint64_t offset, const void* src, size_t length) {
+        const auto* in = static_cast<const uint8_t*>(src);
+        while (length > 0) {
+            const ssize_t n = pwrite(fd, in, length, static_cast<off_t>(offset));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            in += n; offset += n; length -= n;
+        }
+        return true;
+    }
+
+    bool WriteAt(const int fd, const uint64_t offset, const Bytes& bytes) {
+        return WriteAt(fd, offset, bytes.data(), bytes.size());
+    }
+
+    uint64_t GetBE(const uint8_t* p, const int length) {
+        uint64_t value = 0;
+        for (int i = 0; i < length; i++) value = (value << 8) | p[i];
+        return value;
+    }
+
+    void PutBE(Bytes& out, const uint64_t value, const int length) {
+        for (int i = length - 1; i >= 0; i--) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    void Append(Bytes& out, const uint8_t* data, const size_t length) {
+        out.insert(out.end(), data, data + length);
+    }
+
+    void Append(Bytes& out, const Bytes& data) {
+        out.insert(out.end(), data.begin(), data.end());
+    }
+
+    void Append(Bytes& out, const std::string& text) {
+        out.insert(out.end(), text.begin(), text.end());
+    }
+}
+
+// ─── MP4 Boxes ───────────────────────────────────────────────────────────────
+
+namespace {
+    constexpr uint32_t FourCC(const char (&s)[5]) {
+        return static_cast<uint32_t>(static_cast<uint8_t>(s[0])) << 24 |
+               static_cast<uint32_t>(static_cast<uint8_t>(s[1])) << 16 |
+               static_cast<uint32_t>(static_cast<uint8_t>(s[2])) << 8  |
+               static_cast<uint32_t>(static_cast<uint8_t>(s[3]));
+    }
+
+    struct Box {
+        uint64_t offset = 0;
+        uint64_t size   = 0;   // including the header
+        uint32_t header = 8;
+        uint32_t type   = 0;
+        bool     toEnd  = false;   // size 0: runs to the end of its parent
+
+        uint64_t End() const { return offset + size; }
+    };
+
+    // p holds the bytes at offset (up to 16 are needed); end bounds the parent
+    bool ParseBox(const uint8_t* p, const size_t avail, const uint64_t offset, const uint64_t end, Box& box) {
+        if (avail < 8 || end - offset < 8) return false;
+
+        uint64_t size = GetBE(p, 4);
+        box.type   = static_cast<uint32_t>(GetBE(p + 4, 4));
+        box.header = 8;
+        box.toEnd  = false;
+
+        if (size == 1) {
+            if (avail < 16) return false;
+            size = GetBE(p + 8, 8);
+            box.header = 16;
+        } else if (size == 0) {
+            size = end - offset;
+            box.toEnd = true;
+        }
+
+        if (size < box.header || size > end - offset) return false;
+        box.offset = offset;
+        box.size   = size;
+        return true;
+    }
+
+    Bytes MakeBox(const uint32_t type, const Bytes& payload) {
+        Bytes box;
+        if (payload.size() + 8 <= UINT32_MAX) {
+            PutBE(box, payload.size() + 8, 4);
+            PutBE(box, type, 4);
+        } else {
+            PutBE(box, 1, 4);
+            PutBE(box, type, 4);
+            PutBE(box, payload.size() + 16, 8);
+        }
+        Append(box, payload);
+        return box;
+    }
+
+    // Children of a container's payload, or nullopt if they don't parse. A
+    // trailing QuickTime zero terminator (< 8 bytes) is tolerated and dropped.
+    std::optional<std::vector<Box>> ParseChildren(const uint8_t* data, const size_t size) {
+        std::vector<Box> children;
+        for (uint64_t offset = 0; offset < size; ) {
+            Box box;
+            if (!ParseBox(data + offset, size - offset, offset, size, box)) {
+                if (size - offset < 8) break;
+                return std::nullopt;
+            }
+            children.push_back(box);
+            offset = box.End();
+        }
+        return children;
+    }
+}
+
+Bytes ContainerPatcher::BuildMdtaMeta(const Tags& tags) {
+    Bytes hdlr;
+    PutBE(hdlr, 0, 4);                        // version + flags
+    PutBE(hdlr, 0, 4);                        // pre_defined
+    PutBE(hdlr, FourCC("mdta"), 4);
+    PutBE(hdlr, 0, 12);                       // reserved
+    hdlr.push_back(0);                        // empty name
+
+    Bytes keys;
+    Bytes ilst;
+    uint32_t count = 0;
+
+    for (const auto& [key, value] : tags) {
+        if (key.empty() || value.empty()) continue;
+        count++;
+
+        PutBE(keys, key.size() + 8, 4);
+        PutBE(keys, FourCC("mdta"), 4);
+        Append(keys, key);
+
+        Bytes data;
+        PutBE(data, 1, 4);                    // well-known type: UTF-8
+        PutBE(data, 0, 4);                    // locale
+        Append(data, value);
+        Append(ilst, MakeBox(count, MakeBox(FourCC("data"), data)));   // item type = 1-based key index
+    }
+
+    Bytes keysPayload;
+    PutBE(keysPayload, 0, 4);                 // version + flags
+    PutBE(keysPayload, count, 4);
+    Append(keysPayload, keys);
+
+    Bytes meta;
+    PutBE(meta, 0, 4);                        // version + flags
+    Append(meta, MakeBox(FourCC("hdlr"), hdlr));
+    Append(meta, MakeBox(FourCC("keys"), keysPayload));
+    Append(meta, MakeBox(FourCC("ilst"), ilst));
+    return MakeBox(FourCC("meta"), meta);
+}
+
+ContainerPatcher::Result ContainerPatcher::PatchMp4(const int fd, const uint64_t fileSize, const Tags& tags) {
+    // ── Top-level layout ──
+    std::vector<Box> top;
+    for (uint64_t offset = 0; offset < fileSize; ) {
+        uint8_t header[16] = {};
+        const size_t avail = static_cast<size_t>(std::min<uint64_t>(sizeof(header), fileSize - offset));
+        Box box;
+        if (!ReadAt(fd, offset, header, avail) || !ParseBox(header, avail, offset, fileSize, box)) {
+            return Result::NotPatchable;
+        }
+        top.push_back(box);
+        offset = box.End();
+    }
+
+    const auto moovIt = std::ranges::find(top, FourCC("moov"), &Box::type);
+    if (moovIt == top.end() || std::ranges::count(top, FourCC("moov"), &Box::type) != 1) return Result::NotPatchable;
+
+    const Box moov = *moovIt;
+    if (moov.size > kMaxHeaderBytes) return Result::NotPatchable;
+
+    Bytes oldMoov(moov.size);
+    if (!ReadAt(fd, moov.offset, oldMoov.data(), oldMoov.size())) return Result::NotPatchable;
+
+    // ── New moov: udta/meta replaced, everything else byte for byte ──
+    const auto children = ParseChildren(oldMoov.data() + moov.header, moov.size - moov.header);
+    if (!children) return Result::NotPatchable;
+
+    const Bytes meta = BuildMdtaMeta(tags);
+    Bytes moovPayload;
+    bool hasUdta = false;
+
+    for (const auto& child : *children) {
+        const uint8_t* childData = oldMoov.data() + moov.header + child.offset;
+
+        if (child.type != FourCC("udta") || hasUdta) {
+            Append(moovPayload, childData, child.size);
+            continue;
+        }
+
+        const auto udtaChildren = ParseChildren(childData + child.header, child.size - child.header);
+        if (!udtaChildren) return Result::NotPatchable;
+
+        Bytes udta;
+        for (const auto& entry : *udtaChildren) {
+            if (entry.type == FourCC("meta")) continue;
+            Append(udta, childData + child.header + entry.offset, entry.size);
+        }
+        Append(udta, meta);
+        Append(moovPayload, MakeBox(FourCC("udta"), udta));
+        hasUdta = true;
+    }
+    if (!hasUdta) Append(moovPayload, MakeBox(FourCC("udta"), meta));
+
+    const Bytes newMoov = MakeBox(FourCC("moov"), moovPayload);
+
+    // ── Placement ──
+    // Space moov may grow into: itself plus any free/skip boxes right after it
+    uint64_t spanEnd = moov.End();
+    for (auto it = moovIt + 1; it != top.end() && (it->type == FourCC("free") || it->type == FourCC("skip")); ++it) {
+        spanEnd = it->End();
+    }
+    const uint64_t span = spanEnd - moov.offset;
+
+    if (spanEnd == fileSize) {
+        // Tail of the file: rewrite and trim or extend
+        if (!WriteAt(fd, moov.offset, newMoov)) return Result::Failed;
+        if (ftruncate(fd, static_cast<off_t>(moov.offset + newMoov.size())) != 0) return Result::Failed;
+    } else if (newMoov.size() == span || newMoov.size() + 8 <= span) {
+        if (!WriteAt(fd, moov.offset, newMoov)) return Result::Failed;
+
+        if (const uint64_t rest = span - newMoov.size(); rest > 0) {
+            Bytes freeHeader;
+            PutBE(freeHeader, rest, 4);
+            PutBE(freeHeader, FourCC("free"), 4);
+            if (!WriteAt(fd, moov.offset + newMoov.size(), freeHeader)) return Result::Failed;
+        }
+    } else {
+        // Append, then retire the old copy. Until the rename both are valid and
+        // readers take the first, so a crash in between loses nothing.
+        // Fragmented files need moov ahead of the fragments; a size-0 last box
+        // would swallow anything appended.
+        if (std::ranges::count(top, FourCC("moof"), &Box::type) > 0) return Result::NotPatchable;
+        if (top.back().toEnd) return Result::NotPatchable;
+
+        if (!WriteAt(fd, fileSize, newMoov)) return Result::Failed;
+        if (fdatasync(fd) != 0) return Result::Failed;
+
+        Bytes freeType;
+        PutBE(freeType, FourCC("free"), 4);
+        if (!WriteAt(fd, moov.offset + 4, freeType)) return Result::Failed;
+    }
+
+    return fdatasync(fd) == 0 ? Result::Patched : Result::Failed;
+}
+
+// ─── Matroska Elements ───────────────────────────────────────────────────────
+
+namespace {
+    constexpr uint32_t kEbmlId         = 0x1A45DFA3;
+    constexpr uint32_t kSegmentId      = 0x18538067;
+    constexpr uint32_t kSeekHeadId     = 0x114D9B74;
+    constexpr uint32_t kSeekId         = 0x4DBB;
+    constexpr uint32_t kSeekIdId       = 0x53AB;
+    constexpr uint32_t kSeekPositionId = 0x53AC;
+    constexpr uint32_t kTagsId         = 0x1254C367;
+    constexpr uint32_t kTagId          = 0x7373;
+    constexpr uint32_t kTargetsId      = 0x63C0;
+    constexpr uint32_t kSimpleTagId    = 0x67C8;
+    constexpr uint32_t kTagNameId      = 0x45A3;
+    constexpr uint32_t kTagStringId    = 0x4487;
+    constexpr uint32_t kVoidId         = 0xEC;
+    constexpr uint32_t kCrc32Id        = 0xBF;
+
+    // A Tag whose Targets name any of these applies to a track/edition/chapter/attachment
+    constexpr uint32_t kTargetUidIds[] = { 0x63C5, 0x63C9, 0x63C4, 0x63C6 };
+
+    struct Element {
+        uint32_t id          = 0;
+        uint64_t offset      = 0;
+        uint32_t header      = 0;
+        uint32_t sizeLength  = 0;
+        uint64_t size        = 0;   // payload
+        bool     unknownSize = false;
+
+        uint64_t End() const { return offset + header + size; }
+        uint64_t Total() const { return header + size; }
+    };
+
+    // p holds the bytes at offset (up to 12 are needed)
+    bool ParseElement(const uint8_t* p, const size_t avail, const uint64_t offset, Element& element) {
+        if (avail < 2 || p[0] == 0) return false;
+
+        const int idLength = std::countl_zero(p[0]) + 1;
+        if (idLength > 4 || avail < static_cast<size_t>(idLength) + 1 || p[idLength] == 0) return false;
+
+        const int sizeLength = std::countl_zero(p[idLength]) + 1;
+        if (avail < static_cast<size_t>(idLength + sizeLength)) return false;
+
+        const uint64_t raw  = GetBE(p + idLength, sizeLength);
+        const uint64_t mask = (uint64_t{1} << (7 * sizeLength)) - 1;
+
+        element.id          = static_cast<uint32_t>(GetBE(p, idLength));
+        element.offset      = offset;
+        element.header      = static_cast<uint32_t>(idLength + sizeLength);
+        element.sizeLength  = static_cast<uint32_t>(sizeLength);
+        element.size        = raw & mask;
+        element.unknownSize = element.size == mask;
+        return true;
+    }
+
+    std::optional<std::vector<Element>> ParseElements(const uint8_t* data, const size_t size) {
+        std::vector<Element> elements;
+        for (uint64_t offset = 0; offset < size; ) {
+            Element element;
+            if (!ParseElement(data + offset, size - offset, offset, element) ||
+                element.unknownSize || element.End() > size) {
+                return std::nullopt;
+            }
+            elements.push_back(element);
+            offset = element.End();
+        }
+        return elements;
+    }
+
+    void PutId(Bytes& out, const uint32_t id) {
+        const int length = id > 0xFFFFFF ? 4 : id > 0xFFFF ? 3 : id > 0xFF ? 2 : 1;
+        PutBE(out, id, length);
+    }
+
+    // Size vint of exactly `length` bytes; false if the value doesn't fit
+    bool PutSize(Bytes& out, const uint64_t size, const int length) {
+        if (length < 1 || length > 8 || size >= (uint64_t{1} << (7 * length)) - 1) return false;
+        PutBE(out, size | (uint64_t{1} << (7 * length)), length);
+        return true;
+    }
+
+    void PutSize(Bytes& out, const uint64_t size) {
+        int length = 1;
+        while (length < 8 && size >= (uint64_t{1} << (7 * length)) - 1) length++;
+        PutSize(out, size, length);
+    }
+
+    Bytes MakeElement(const uint32_t id, const Bytes& payload) {
+        Bytes element;
+        PutId(element, id);
+        PutSize(element, payload.size());
+        Append(element, payload);
+        return element;
+    }
+
+    Bytes MakeString(const uint32_t id, const std::string& text) {
+        return MakeElement(id, Bytes(text.begin(), text.end()));
+    }
+
+    Bytes MakeUInt(const uint32_t id, const uint64_t value) {
+        int length = 1;
+        while (length < 8 && (value >> (8 * length)) != 0) length++;
+        Bytes payload;
+        PutBE(payload, value, length);
+        return MakeElement(id, payload);
+    }
+
+    // Header of a Void element occupying exactly `total` bytes (>= 2)
+    Bytes MakeVoidHeader(const uint64_t total) {
+        Bytes header;
+        for (int length = 1; length <= 8; length++) {
+            if (total < static_cast<uint64_t>(1 + length)) break;
+            header.clear();
+            PutId(header, kVoidId);
+            if (PutSize(header, total - 1 - length, length)) return header;
+        }
+        return {};
+    }
+
+    bool IsGlobalTag(const uint8_t* payload, const size_t size) {
+        const auto children = ParseElements(payload, size);
+        if (!children) return false;
+
+        for (const auto& child : *children) {
+            if (child.id != kTargetsId) continue;
+            const auto targets = ParseElements(payload + child.offset + child.header, child.size);
+            if (!targets) return false;
+            for (const auto& target : *targets) {
+                if (std::ranges::find(kTargetUidIds, target.id) != std::end(kTargetUidIds)) return false;
+            }
+        }
+        return true;
+    }
+
+    // Reads the element header at offset, within [offset, end)
+    bool ReadElement(const int fd, const uint64_t offset, const uint64_t end, Element& element) {
+        uint8_t header[12] = {};
+        const size_t avail = static_cast<size_t>(std::min<uint64_t>(sizeof(header), end - offset));
+        return ReadAt(fd, offset, header, avail) && ParseElement(header, avail, offset, element);
+    }
+
+    bool ReadPayload(const int fd, const Element& element, Bytes& payload) {
+        payload.resize(element.size);
+        return ReadAt(fd, element.offset + element.header, payload.data(), payload.size());
+    }
+}
+
+Bytes ContainerPatcher::BuildMatroskaTag(const Tags& tags) {
+    Bytes payload = MakeElement(kTargetsId, {});   // no UIDs: applies to the whole file
+
+    for (const auto& [key, value] : tags) {
+        if (key.empty() || value.empty()) continue;
+        Bytes simpleTag = MakeString(kTagNameId, key);
+        Append(simpleTag, MakeString(kTagStringId, value));
+        Append(payload, MakeElement(kSimpleTagId, simpleTag));
+    }
+    return MakeElement(kTagId, payload);
+}
+
+ContainerPatcher::Result ContainerPatcher::PatchMatroska(const int fd, const uint64_t fileSize, const Tags& tags) {
+    // ── Segment layout ──
+    Element ebml, segment;
+    if (!ReadElement(fd, 0, fileSize, ebml) || ebml.id != kEbmlId || ebml.unknownSize) return Result::NotPatchable;
+    if (!ReadElement(fd, ebml.End(), fileSize, segment) || segment.id != kSegmentId) return Result::NotPatchable;
+
+    const uint64_t segmentData = segment.offset + segment.header;
+    const uint64_t segmentEnd  = segment.unknownSize ? fileSize : segment.End();
+    if (segmentEnd > fileSize) return Result::NotPatchable;
+
+    std::vector<Element> children;
+    for (uint64_t offset = segmentData; offset < segmentEnd; ) {
+        Element element;
+        if (!ReadElement(fd, offset, segmentEnd, element) || element.unknownSize || element.End() > segmentEnd) {
+            return Result::NotPatchable;   // e.g. live-written clusters without sizes
+        }
+        children.push_back(element);
+        offset = element.End();
+    }
+
+    const auto tagsIt     = std::ranges::find(children, kTagsId, &Element::id);
+    const auto seekHeadIt = std::ranges::find(children, kSeekHeadId, &Element::id);
+    if (std::ranges::count(children, kTagsId, &Element::id) > 1) return Result::NotPatchable;
+
+    // ── New Tags: non-global Tag elements kept, the global one replaced ──
+    Bytes tagsPayload;
+    if (tagsIt != children.end()) {
+        Bytes oldPayload;
+        if (tagsIt->size > kMaxHeaderBytes || !ReadPayload(fd, *tagsIt, oldPayload)) return Result::NotPatchable;
+
+        const auto entries = ParseElements(oldPayload.data(), oldPayload.size());
+        if (!entries) return Result::NotPatchable;
+
+        for (const auto& entry : *entries) {
+            if (entry.id != kTagId) continue;   // CRC-32 / Void are not carried over
+            const uint8_t* entryData = oldPayload.data() + entry.offset;
+            if (IsGlobalTag(entryData + entry.header, entry.size)) continue;
+            Append(tagsPayload, entryData, entry.Total());
+        }
+    }
+    Append(tagsPayload, BuildMatroskaTag(tags));
+    const Bytes newTags = MakeElement(kTagsId, tagsPayload);
+
+    // Bytes from an element to the end of any Void run after it
+    const auto spanOf = [&](const std::vector<Element>::const_iterator it) {
+        uint64_t end = it->End();
+        for (auto next = it + 1; next != children.end() && next->id == kVoidId; ++next) end = next->End();
+        return end - it->offset;
+    };
+    const auto fits = [](const uint64_t size, const uint64_t span) {
+        return size == span || size + 2 <= span;   // a Void needs at least 2 bytes
+    };
+
+    const auto writeSegmentSize = [&](const uint64_t newEnd) {
+        if (segment.unknownSize) return true;
+        Bytes size;
+        return PutSize(size, newEnd - segmentData, static_cast<int>(segment.sizeLength)) &&
+               WriteAt(fd, segment.offset + segment.header - segment.sizeLength, size);
+    };
+    const auto canResizeSegment = [&](const uint64_t newEnd) {
+        Bytes scratch;
+        return segment.unknownSize || PutSize(scratch, newEnd - segmentData, static_cast<int>(segment.sizeLength));
+    };
+
+    // ── In place ──
+    if (tagsIt != children.end()) {
+        const uint64_t span = spanOf(tagsIt);
+
+        if (fits(newTags.size(), span)) {
+            if (!WriteAt(fd, tagsIt->offset, newTags)) return Result::Failed;
+            if (const uint64_t rest = span - newTags.size(); rest > 0) {
+                if (!WriteAt(fd, tagsIt->offset + newTags.size(), MakeVoidHeader(rest))) return Result::Failed;
+            }
+            return fdatasync(fd) == 0 ? Result::Patched : Result::Failed;
+        }
+
+        if (tagsIt->offset + span == segmentEnd && segmentEnd == fileSize) {
+            const uint64_t newEnd = tagsIt->offset + newTags.size();
+            if (!canResizeSegment(newEnd)) return Result::NotPatchable;
+
+            if (!WriteAt(fd, tagsIt->offset, newTags)) return Result::Failed;
+            if (ftruncate(fd, static_cast<off_t>(newEnd)) != 0) return Result::Failed;
+            if (!writeSegmentSize(newEnd)) return Result::Failed;
+            return fdatasync(fd) == 0 ? Result::Patched : Result::Failed;
+        }
+    }
+
+    // ── Append: Tags at the end, SeekHead pointed at it ──
+    if (segmentEnd != fileSize || seekHeadIt == children.end()) return Result::NotPatchable;
+
+    const uint64_t newEnd = fileSize + newTags.size();
+    if (!canResizeSegment(newEnd)) return Result::NotPatchable;
+
+    Bytes oldSeekHead;
+    if (seekHeadIt->size > kMaxHeaderBytes || !ReadPayload(fd, *seekHeadIt, oldSeekHead)) return Result::NotPatchable;
+
+    const auto seeks = ParseElements(oldSeekHead.data(), oldSeekHead.size());
+    if (!seeks) return Result::NotPatchable;
+
+    Bytes tagsIdBytes;
+    PutId(tagsIdBytes, kTagsId);
+
+    Bytes seekHeadPayload;
+    for (const auto& seek : *seeks) {
+        if (seek.id != kSeekId) continue;
+        const uint8_t* seekData = oldSeekHead.data() + seek.offset;
+
+        const auto fields = ParseElements(seekData + seek.header, seek.size);
+        if (!fields) return Result::NotPatchable;
+
+        const auto idField = std::ranges::find(*fields, kSeekIdId, &Element::id);
+        if (idField != fields->end()) {
+            const uint8_t* idData = seekData + seek.header + idField->offset + idField->header;
+            if (Bytes(idData, idData + idField->size) == tagsIdBytes) continue;
+        }
+        Append(seekHeadPayload, seekData, seek.Total());
+    }
+
+    Bytes tagsSeek = MakeElement(kSeekIdId, tagsIdBytes);
+    Append(tagsSeek, MakeUInt(kSeekPositionId, fileSize - segmentData));
+    Append(seekHeadPayload, MakeElement(kSeekId, tagsSeek));
+
+    const Bytes newSeekHead = MakeElement(kSeekHeadId, seekHeadPayload);
+    const uint64_t seekHeadSpan = spanOf(seekHeadIt);
+    if (!fits(newSeekHead.size(), seekHeadSpan)) return Result::NotPatchable;
+
+    // Each step leaves a readable file: the appended Tags is unreferenced until
+    // the SeekHead points at it, and the old one is only voided afterwards
+    if (!WriteAt(fd, fileSize, newTags)) return Result::Failed;
+    if (!writeSegmentSize(newEnd)) return Result::Failed;
+    if (fdatasync(fd) != 0) return Result::Failed;
+
+    if (!WriteAt(fd, seekHeadIt->offset, newSeekHead)) return Result::Failed;
+    if (const uint64_t rest = seekHeadSpan - newSeekHead.size(); rest > 0) {
+        if (!WriteAt(fd, seekHeadIt->offset + newSeekHead.size(), MakeVoidHeader(rest))) return Result::Failed;
+    }
+
+    if (tagsIt != children.end()) {
+        if (fdatasync(fd) != 0) return Result::Failed;
+        if (!WriteAt(fd, tagsIt->offset, MakeVoidHeader(tagsIt->Total()))) return Result::Failed;
+    }
+
+    return fdatasync(fd) == 0 ? Result::Patched : Result::Failed;
+}
+
+// ─── Entry Point ─────────────────────────────────────────────────────────────
+
+ContainerPatcher::Result ContainerPatcher::WriteTags(const std::string& videoPath, const Tags& tags) {
+    const FileHandle file(videoPath);
+    if (file.fd < 0) return Result::NotPatchable;
+
+    struct stat st{};
+    if (fstat(file.fd, &st) != 0 || !S_ISREG(st.st_mode)) return Result::NotPatchable;
+    const auto fileSize = static_cast<uint64_t>(st.st_size);
+
+    uint8_t magic[4] = {};
+    if (fileSize < sizeof(magic) || !ReadAt(file.fd, 0, magic, sizeof(magic))) return Result::NotPatchable;
+
+    Result result = Result::NotPatchable;
+    if (GetBE(magic, 4) == kEbmlId) {
+        result = PatchMatroska(file.fd, fileSize, tags);
+    } else {
+        std::string ext = fs::path(videoPath).extension().string();
+        std::ranges::transform(ext, ext.begin(), ::tolower);
+        if (ext == ".mp4" || ext == ".mov" || ext == ".m4v") {
+            result = PatchMp4(file.fd, fileSize, tags);
+        }
+    }
+
+    if (result == Result::Failed) {
+        std::cerr << "[ContainerPatcher] Write failed for " << videoPath
+                  << ": " << std::strerror(errno) << std::endl;
+    }
+    return result;
+}
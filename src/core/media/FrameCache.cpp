@@ -0,0 +1,76 @@
+#include "core/media/FrameCache.h"
+
+extern "C" {
+#include <libavutil/imgutils.h>
+}
+
+FrameCache::~FrameCache() {
+    Clear();
+}
+
+void FrameCache::Insert(const double seconds, const AVFrame* frame) {
+    std::lock_guard lock(m_mutex);
+
+    if (auto it = m_entries.find(seconds); it != m_entries.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lruPos);
+        return;
+    }
+
+    AVFrame* ref = av_frame_alloc();
+    if (!ref) return;
+    if (av_frame_ref(ref, frame) < 0) {
+        av_frame_free(&ref);
+        return;
+    }
+
+    const int size = av_image_get_buffer_size(static_cast<AVPixelFormat>(frame->format),
+                                              frame->width, frame->height, 1);
+    m_lru.push_front(seconds);
+
+    Entry entry;
+    entry.frame  = ref;
+    entry.bytes  = size > 0 ? static_cast<size_t>(size) : 0;
+    entry.lruPos = m_lru.begin();
+    m_bytes += entry.bytes;
+    m_entries.emplace(seconds, entry);
+
+    EvictLocked();
+}
+
+AVFrame* FrameCache::Find(const double seconds, const double frameDuration) {
+    std::lock_guard lock(m_mutex);
+
+    // The frame on screen is the last one that starts at or before `seconds`
+    auto it = m_entries.upper_bound(seconds + frameDuration * 0.5);
+    if (it == m_entries.begin()) return nullptr;
+    --it;
+    if (seconds - it->first >= frameDuration) return nullptr;   // gap: frame not cached
+
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lruPos);
+
+    AVFrame* ref = av_frame_alloc();
+    if (ref && av_frame_ref(ref, it->second.frame) < 0)
+        av_frame_free(&ref);
+    return ref;
+}
+
+void FrameCache::Clear() {
+    std::lock_guard lock(m_mutex);
+    for (auto& [_, entry] : m_entries)
+        av_frame_free(&entry.frame);
+    m_entries.clear();
+    m_lru.clear();
+    m_bytes = 0;
+}
+
+void FrameCache::EvictLocked() {
+    while (m_bytes > m_maxBytes && !m_lru.empty()) {
+        auto it = m_entries.find(m_lru.back());
+        m_lru.pop_back();
+        if (it == m_entries.end()) continue;
+
+        m_bytes -= it->second.bytes;
+        av_frame_free(&it->second.frame);
+        m_entries.erase(it);
+    }
+}
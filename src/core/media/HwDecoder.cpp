@@ -0,0 +1,118 @@
+#include "core/media/HwDecoder.h"
+
+#include <iostream>
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+}
+
+std::mutex   HwDecoder::s_mutex;
+HwDecodeMode HwDecoder::s_mode         = HwDecodeMode::Auto;
+std::string  HwDecoder::s_devicePath;
+AVBufferRef* HwDecoder::s_device       = nullptr;
+bool         HwDecoder::s_deviceFailed = false;
+std::unordered_set<std::string> HwDecoder::s_warnedCodecs;
+
+void HwDecoder::Configure(const HwDecodeMode mode, const std::string& devicePath) {
+    std::lock_guard lock(s_mutex);
+    if (mode != s_mode || devicePath != s_devicePath) {
+        av_buffer_unref(&s_device);
+        s_deviceFailed = false;
+        s_warnedCodecs.clear();
+    }
+    s_mode       = mode;
+    s_devicePath = devicePath;
+}
+
+void HwDecoder::Shutdown() {
+    std::lock_guard lock(s_mutex);
+    av_buffer_unref(&s_device);
+}
+
+AVBufferRef* HwDecoder::AcquireDevice() {
+    std::lock_guard lock(s_mutex);
+    if (s_mode == HwDecodeMode::Off || s_deviceFailed) return nullptr;
+
+    if (!s_device) {
+        // A DRM render node needs no display server, so this also works headless
+        const char* device = s_devicePath.empty() ? nullptr : s_devicePath.c_str();
+        const int ret = av_hwdevice_ctx_create(&s_device, AV_HWDEVICE_TYPE_VAAPI, device, nullptr, 0);
+        if (ret < 0) {
+            char err[AV_ERROR_MAX_STRING_SIZE];
+            av_strerror(ret, err, sizeof(err));
+            if (s_mode == HwDecodeMode::VAAPI) {
+                std::cerr << "[HwDecoder] ERROR: hw_decode is set to vaapi but the VAAPI device"
+                          << (device ? std::string(" ") + device : std::string())
+                          << " could not be opened (" << err << "); ALL video will decode on the CPU" << std::endl;
+            } else {
+                std::cerr << "[HwDecoder] VAAPI unavailable (" << err << "), using software decode" << std::endl;
+            }
+            s_deviceFailed = true;
+            s_device = nullptr;
+            return nullptr;
+        }
+        std::cout << "[HwDecoder] VAAPI device ready"
+                  << (device ? std::string(" on ") + device : std::string()) << std::endl;
+    }
+    return av_buffer_ref(s_device);
+}
+
+bool HwDecoder::Attach(AVCodecContext* codecCtx, const AVCodec* codec) {
+    if (!codecCtx || !codec || codec->type != AVMEDIA_TYPE_VIDEO) return false;
+
+    bool supported = false;
+    for (int i = 0;; i++) {
+        const AVCodecHWConfig* config = avcodec_get_hw_config(codec, i);
+        if (!config) break;
+        if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX)
+            && config->device_type == AV_HWDEVICE_TYPE_VAAPI) {
+            supported = true;
+            break;
+        }
+    }
+    if (!supported) {
+        WarnForcedFallback(codec->name, "has no VAAPI decoder");
+        return false;
+    }
+
+    AVBufferRef* device = AcquireDevice();
+    if (!device) return false;
+
+    codecCtx->hw_device_ctx = device;
+    codecCtx->get_format    = &HwDecoder::GetFormat;
+    return true;
+}
+
+void HwDecoder::WarnForcedFallback(const std::string& codecName, const char* reason) {
+    std::lock_guard lock(s_mutex);
+    if (s_mode != HwDecodeMode::VAAPI || !s_warnedCodecs.insert(codecName).second) return;
+
+    std::cerr << "[HwDecoder] ERROR: hw_decode is set to vaapi but " << codecName << " " << reason
+              << "; these videos decode on the CPU" << std::endl;
+}
+
+AVPixelFormat HwDecoder::GetFormat(AVCodecContext* codecCtx, const AVPixelFormat* formats) {
+    for (const AVPixelFormat* p = formats; *p != AV_PIX_FMT_NONE; p++) {
+        if (*p == AV_PIX_FMT_VAAPI) return *p;
+    }
+
+    // No VAAPI path for this stream (profile, bit depth, ...): take the first software format
+    WarnForcedFallback(codecCtx->codec ? codecCtx->codec->name : "this codec", "has no VAAPI path for this profile");
+    for (const AVPixelFormat* p = formats; *p != AV_PIX_FMT_NONE; p++) {
+        const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(*p);
+        if (desc && !(desc->flags & AV_PIX_FMT_FLAG_HWACCEL)) return *p;
+    }
+    return avcodec_default_get_format(codecCtx, formats);
+}
+
+const AVFrame* HwDecoder::Download(const AVFrame* frame, AVFrame* swFrame) {
+    if (!frame || frame->format != AV_PIX_FMT_VAAPI) return frame;
+
+    av_frame_unref(swFrame);
+    if (av_hwframe_transfer_data(swFrame, frame, 0) < 0) {
+        std::cerr << "[HwDecoder] Failed to download VAAPI frame" << std::endl;
+        return nullptr;
+    }
+    av_frame_copy_props(swFrame, frame);
+    return swFrame;
+}
@@ -0,0 +1,224 @@
+#include "core/media/IntegrityChecker.h"
+#include "core/media/MediaProbe.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <future>
+#include <thread>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+namespace fs = std::filesystem;
+
+namespace {
+    // The container's duration, or the longest stream's when the container has none
+    int64_t DurationUs(const AVFormatContext* ctx) {
+        if (ctx->duration != AV_NOPTS_VALUE && ctx->duration > 0) return ctx->duration;
+
+        int64_t longest = 0;
+        for (unsigned int i = 0; i < ctx->nb_streams; i++) {
+            const AVStream* stream = ctx->streams[i];
+            if (stream->duration == AV_NOPTS_VALUE || stream->duration <= 0) continue;
+            longest = std::max(longest, av_rescale_q(stream->duration, stream->time_base, AVRational{1, AV_TIME_BASE}));
+        }
+        return longest;
+    }
+
+    // Frames the decoder has ready; anything but "needs more input" is an error
+    int DrainFrames(AVCodecContext* codecCtx, AVFrame* frame, int& errors) {
+        int frames = 0;
+        int ret;
+        while ((ret = avcodec_receive_frame(codecCtx, frame)) >= 0) {
+            frames++;
+            av_frame_unref(frame);
+        }
+        if (ret != AVERROR(EAGAIN) && ret != AVERROR_EOF) errors++;
+        return frames;
+    }
+
+    // Reads from the current position to EOF (or maxPackets). With a codec
+    // context, the video stream's packets are decoded on the way.
+    IntegrityChecker::Verdict ReadPackets(AVFormatContext* ctx,
+                                          AVCodecContext* codecCtx,
+                                          const int videoStream,
+                                          const int maxPackets) {
+        using Verdict = IntegrityChecker::Verdict;
+
+        const int64_t fileSize = ctx->pb ? avio_size(ctx->pb) : -1;
+
+        AVPacket* packet = av_packet_alloc();
+        AVFrame* frame   = codecCtx ? av_frame_alloc() : nullptr;
+
+        int  packets = 0, videoPackets = 0, frames = 0, errors = 0;
+        int  ret = 0;
+        bool truncated = false;
+
+        while (maxPackets <= 0 || packets < maxPackets) {
+            ret = av_read_frame(ctx, packet);
+            if (ret < 0) break;
+            packets++;
+
+            // A sample table pointing past the end of the file: the recording was cut
+            if (packet->flags & AV_PKT_FLAG_CORRUPT) truncated = true;
+            if (fileSize > 0 && packet->pos >= 0 && packet->pos + packet->size > fileSize) truncated = true;
+
+            if (codecCtx && packet->stream_index == videoStream) {
+                videoPackets++;
+                if (avcodec_send_packet(codecCtx, packet) < 0) errors++;
+                frames += DrainFrames(codecCtx, frame, errors);
+            }
+
+            av_packet_unref(packet);
+            if (truncated) break;
+        }
+
+        if (ret < 0 && ret != AVERROR_EOF) truncated = true;
+        if (packets == 0) truncated = true;
+
+        if (codecCtx && !truncated && avcodec_send_packet(codecCtx, nullptr) == 0) {
+            frames += DrainFrames(codecCtx, frame, errors);
+        }
+
+        av_frame_free(&frame);
+        av_packet_free(&packet);
+
+        if (truncated) return Verdict::Truncated;
+        if (!codecCtx) return Verdict::Ok;
+
+        if (frames == 0 || errors * 100 > videoPackets * IntegrityChecker::kMaxErrorsPercent) {
+            return Verdict::Undecodable;
+        }
+        return Verdict::Ok;
+    }
+
+    IntegrityChecker::Verdict CheckTail(AVFormatContext* ctx, const int64_t durationUs) {
+        const int64_t start  = ctx->start_time != AV_NOPTS_VALUE ? ctx->start_time : 0;
+        const int64_t target = start + std::max<int64_t>(0, durationUs - IntegrityChecker::kTailWindowUs);
+
+        // Without a seek the tail is only reachable by reading the whole file;
+        // the header check has to do
+        if (av_seek_frame(ctx, -1, target, AVSEEK_FLAG_BACKWARD) < 0) {
+            return IntegrityChecker::Verdict::Ok;
+        }
+        return ReadPackets(ctx, nullptr, -1, IntegrityChecker::kMaxTailPackets);
+    }
+
+    IntegrityChecker::Verdict DecodeAll(const MediaProbe& probe) {
+        using Verdict = IntegrityChecker::Verdict;
+
+        if (!probe.HasVideo()) return Verdict::Undecodable;
+
+        AVFormatContext* ctx  = probe.GetFormatContext();
+        const int streamIndex = probe.GetVideoStreamIndex();
+        const AVCodecParameters* codecParams = ctx->streams[streamIndex]->codecpar;
+
+        const AVCodec* codec = avcodec_find_decoder(codecParams->codec_id);
+        if (!codec) return Verdict::Undecodable;
+
+        AVCodecContext* codecCtx = avcodec_alloc_context3(codec);
+        avcodec_parameters_to_context(codecCtx, codecParams);
+        codecCtx->thread_count = 1;   // files are checked in parallel instead
+
+        if (avcodec_open2(codecCtx, codec, nullptr) < 0) {
+            avcodec_free_context(&codecCtx);
+            return Verdict::Undecodable;
+        }
+
+        // Every stream is read, not just video, so a cut audio track counts too
+        const Verdict verdict = ReadPackets(ctx, codecCtx, streamIndex, 0);
+
+        avcodec_free_context(&codecCtx);
+        return verdict;
+    }
+}
+
+IntegrityChecker::IntegrityChecker(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::clamp<size_t>(std::thread::hardware_concurrency() / 4, 1, 4);
+    }
+    m_pool = std::make_unique<ThreadPool>(threadCount);
+}
+
+IntegrityChecker::Verdict IntegrityChecker::Inspect(const std::string& videoPath, const bool deepDecode) {
+    std::error_code ec;
+    if (!fs::is_regular_file(videoPath, ec)) return Verdict::Missing;
+
+    // Header only for the quick check; decoding needs the stream analysis
+    MediaProbe probe(videoPath, deepDecode);
+    if (!probe.IsOpen()) return Verdict::Unreadable;
+
+    // Streamed containers keep no duration in the header; the bounded stream
+    // probe estimates one, as ffprobe does, before the file is held against it
+    int64_t durationUs = DurationUs(probe.GetFormatContext());
+    if (durationUs <= 0 && probe.FindStreams()) {
+        durationUs = DurationUs(probe.GetFormatContext());
+    }
+    if (durationUs <= 0) return Verdict::NoDuration;
+
+    return deepDecode ? DecodeAll(probe) : CheckTail(probe.GetFormatContext(), durationUs);
+}
+
+IntegrityChecker::Verdict IntegrityChecker::Check(const std::string& videoPath, const bool deepDecode) {
+    const auto fingerprint = FileFingerprint::Read(videoPath);
+    if (!fingerprint) {
+        std::lock_guard lock(m_cacheMutex);
+        m_cache.erase(videoPath);
+        return Verdict::Missing;
+    }
+
+    {
+        std::lock_guard lock(m_cacheMutex);
+        if (const auto it = m_cache.find(videoPath); it != m_cache.end()) {
+            const CacheEntry& entry = it->second;
+            // A quick failure stands for the deep check too; a quick pass doesn't
+            if (entry.fingerprint == *fingerprint &&
+                (entry.deep || !deepDecode || entry.verdict != Verdict::Ok)) {
+                return entry.verdict;
+            }
+        }
+    }
+
+    // Keyed by the fingerprint from before the check: a file still being
+    // written gets a new one and is checked again next time
+    const Verdict verdict = Inspect(videoPath, deepDecode);
+
+    std::lock_guard lock(m_cacheMutex);
+    m_cache[videoPath] = CacheEntry{*fingerprint, deepDecode, verdict};
+    return verdict;
+}
+
+std::vector<IntegrityChecker::Verdict> IntegrityChecker::CheckAll(
+    const std::vector<std::string>& videoPaths,
+    const bool deepDecode) {
+
+    std::vector<std::future<Verdict>> futures;
+    futures.reserve(videoPaths.size());
+    for (const auto& path : videoPaths) {
+        futures.push_back(m_pool->Submit([this, path, deepDecode] { return Check(path, deepDecode); }));
+    }
+
+    std::vector<Verdict> verdicts;
+    verdicts.reserve(futures.size());
+    for (auto& future : futures) verdicts.push_back(future.get());
+    return verdicts;
+}
+
+void IntegrityChecker::ClearCache() {
+    std::lock_guard lock(m_cacheMutex);
+    m_cache.clear();
+}
+
+const char* IntegrityChecker::ToString(const Verdict verdict) {
+    switch (verdict) {
+        case Verdict::Ok:          return "ok";
+        case Verdict::Missing:     return "missing";
+        case Verdict::Unreadable:  return "unreadable header";
+        case Verdict::NoDuration:  return "no duration";
+        case Verdict::Truncated:   return "truncated";
+        case Verdict::Undecodable: return "undecodable";
+    }
+    return "unknown";
+}
@@ -0,0 +1,160 @@
+#include "core/media/KeyframeIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char     kMagic[4] = {'M', 'K', 'F', 'I'};
+    constexpr uint32_t kVersion  = 1;
+}
+
+bool KeyframeIndex::LoadOrBuild(const std::string& videoPath,
+                                const fs::path& indexPath,
+                                const std::atomic<bool>& cancel) {
+    if (!ReadFileStamp(videoPath, m_fileSize, m_fileMtime)) return false;
+
+    if (!indexPath.empty() && Load(indexPath)) return true;
+
+    if (!Build(videoPath, cancel)) return false;
+
+    if (!indexPath.empty()) Save(indexPath);
+    return true;
+}
+
+double KeyframeIndex::KeyframeAtOrBefore(const double seconds) const {
+    auto it = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), seconds);
+    if (it == m_keyframes.begin()) return -1.0;
+    return *(--it);
+}
+
+bool KeyframeIndex::ReadFileStamp(const std::string& videoPath, uint64_t& size, int64_t& mtime) {
+    std::error_code ec;
+    size = fs::file_size(videoPath, ec);
+    if (ec) return false;
+    mtime = fs::last_write_time(videoPath, ec).time_since_epoch().count();
+    return !ec;
+}
+
+// ─── Build ───────────────────────────────────────────────────────────────────
+
+bool KeyframeIndex::Build(const std::string& videoPath, const std::atomic<bool>& cancel) {
+    AVFormatContext* formatCtx = nullptr;
+    if (avformat_open_input(&formatCtx, videoPath.c_str(), nullptr, nullptr) != 0) {
+        std::cerr << "[KeyframeIndex] Failed to open: " << videoPath << std::endl;
+        return false;
+    }
+    if (avformat_find_stream_info(formatCtx, nullptr) < 0) {
+        avformat_close_input(&formatCtx);
+        return false;
+    }
+
+    const int streamIndex = av_find_best_stream(formatCtx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (streamIndex < 0) {
+        avformat_close_input(&formatCtx);
+        return false;
+    }
+
+    for (unsigned int i = 0; i < formatCtx->nb_streams; i++) {
+        if (static_cast<int>(i) != streamIndex)
+            formatCtx->streams[i]->discard = AVDISCARD_ALL;
+    }
+
+    const double timeBase = av_q2d(formatCtx->streams[streamIndex]->time_base);
+    AVPacket* packet = av_packet_alloc();
+    m_keyframes.clear();
+
+    // Packets only — no decoding, so this is bound by disk reads
+    while (!cancel && av_read_frame(formatCtx, packet) >= 0) {
+        if (packet->stream_index == streamIndex && (packet->flags & AV_PKT_FLAG_KEY)) {
+            const int64_t ts = packet->pts != AV_NOPTS_VALUE ? packet->pts : packet->dts;
+            if (ts != AV_NOPTS_VALUE)
+                m_keyframes.push_back(ts * timeBase);
+        }
+        av_packet_unref(packet);
+    }
+
+    av_packet_free(&packet);
+    avformat_close_input(&formatCtx);
+
+    if (cancel) {
+        m_keyframes.clear();
+        return false;
+    }
+
+    std::sort(m_keyframes.begin(), m_keyframes.end());
+    std::cout << "[KeyframeIndex] Indexed " << m_keyframes.size()
+              << " keyframes in " << fs::path(videoPath).filename().string() << std::endl;
+    return !m_keyframes.empty();
+}
+
+// ─── Persistence ─────────────────────────────────────────────────────────────
+
+bool KeyframeIndex::Load(const fs::path& indexPath) {
+    std::ifstream in(indexPath, std::ios::binary);
+    if (!in) return false;
+
+    char     magic[4];
+    uint32_t version = 0;
+    uint64_t fileSize = 0, count = 0;
+    int64_t  fileMtime = 0;
+
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&fileSize), sizeof(fileSize));
+    in.read(reinterpret_cast<char*>(&fileMtime), sizeof(fileMtime));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion)
+        return false;
+
+    // Stale: the clip was rewritten since the index was made
+    if (fileSize != m_fileSize || fileMtime != m_fileMtime || count == 0)
+        return false;
+
+    // The count comes from disk: it must match what is left of the file
+    // exactly, or a corrupt header would size the allocation
+    const std::streamoff headerEnd = in.tellg();
+    in.seekg(0, std::ios::end);
+    const std::streamoff remaining = in.tellg() - headerEnd;
+    in.seekg(headerEnd);
+    if (!in || remaining < 0 || count != static_cast<uint64_t>(remaining) / sizeof(double) ||
+        static_cast<uint64_t>(remaining) % sizeof(double) != 0)
+        return false;
+
+    m_keyframes.resize(count);
+    in.read(reinterpret_cast<char*>(m_keyframes.data()),
+            static_cast<std::streamsize>(count * sizeof(double)));
+    if (!in) {
+        m_keyframes.clear();
+        return false;
+    }
+    return true;
+}
+
+bool KeyframeIndex::Save(const fs::path& indexPath) const {
+    std::error_code ec;
+    fs::create_directories(indexPath.parent_path(), ec);
+
+    std::ofstream out(indexPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "[KeyframeIndex] Failed to write: " << indexPath << std::endl;
+        return false;
+    }
+
+    const uint64_t count = m_keyframes.size();
+    out.write(kMagic, sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+    out.write(reinterpret_cast<const char*>(&m_fileSize), sizeof(m_fileSize));
+    out.write(reinterpret_cast<const char*>(&m_fileMtime), sizeof(m_fileMtime));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.write(reinterpret_cast<const char*>(m_keyframes.data()),
+              static_cast<std::streamsize>(count * sizeof(double)));
+    return static_cast<bool>(out);
+}
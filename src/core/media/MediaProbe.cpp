@@ -0,0 +1,95 @@
+#include "core/media/MediaProbe.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+MediaProbe::MediaProbe(const std::string& path, const bool findStreams)
+    : m_path(path) {
+
+    m_formatCtx = avformat_alloc_context();
+    if (!m_formatCtx) return;
+
+    m_formatCtx->probesize            = kProbeSizeBytes;
+    m_formatCtx->max_analyze_duration = kAnalyzeDurationUs;
+
+    // Frees the context and nulls it on failure
+    if (avformat_open_input(&m_formatCtx, path.c_str(), nullptr, nullptr) != 0) {
+        m_formatCtx = nullptr;
+        return;
+    }
+
+    const AVDictionaryEntry* tag = nullptr;
+    while ((tag = av_dict_get(m_formatCtx->metadata, "", tag, AV_DICT_IGNORE_SUFFIX))) {
+        std::string key = tag->key;
+        std::ranges::transform(key, key.begin(), [](const unsigned char c) { return std::tolower(c); });
+        m_tags[key] = tag->value;
+    }
+
+    if (findStreams) FindStreams();
+}
+
+bool MediaProbe::FindStreams() {
+    if (!m_formatCtx) return false;
+    if (m_streamsFound) return true;
+
+    if (avformat_find_stream_info(m_formatCtx, nullptr) < 0) {
+        std::cerr << "[MediaProbe] No stream info for " << m_path << std::endl;
+        return false;
+    }
+    m_streamsFound = true;
+
+    m_videoStream = av_find_best_stream(m_formatCtx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (m_videoStream < 0) m_videoStream = -1;
+    return true;
+}
+
+MediaProbe::~MediaProbe() {
+    Close();
+}
+
+void MediaProbe::Close() {
+    if (m_formatCtx) avformat_close_input(&m_formatCtx);
+    m_videoStream  = -1;
+    m_streamsFound = false;
+}
+
+void MediaProbe::FillVideoInfo(VideoInfo& info) const {
+    info.filePath       = m_path;
+    info.filePathString = m_path;
+    info.name           = fs::path(m_path).filename().string();
+
+    std::error_code ec;
+    if (const auto size = fs::file_size(m_path, ec); !ec) {
+        info.fileSize = static_cast<int64_t>(size);
+    }
+    if (const auto ftime = fs::last_write_time(m_path, ec); !ec) {
+        const auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+            ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()
+        );
+        info.lastModified = std::chrono::system_clock::to_time_t(sctp);
+    }
+    info.fingerprint = FileFingerprint::Read(m_path).value_or(FileFingerprint{});
+
+    if (!m_formatCtx) return;
+
+    if (m_formatCtx->duration != AV_NOPTS_VALUE) {
+        info.durationSec = static_cast<double>(m_formatCtx->duration) / AV_TIME_BASE;
+    }
+
+    if (m_videoStream < 0) return;
+
+    const AVStream* stream = m_formatCtx->streams[m_videoStream];
+    info.resolutionWidth  = stream->codecpar->width;
+    info.resolutionHeight = stream->codecpar->height;
+
+    const AVRational rate = stream->avg_frame_rate.num > 0 ? stream->avg_frame_rate : stream->r_frame_rate;
+    if (rate.num > 0 && rate.den > 0) {
+        info.frameRate = static_cast<int>(std::lround(av_q2d(rate)));
+    }
+}
@@ -1,5 +1,9 @@
 #include "core/media/MetadataEmbedder.h"
+#include "core/media/ContainerPatcher.h"
+#include "core/media/MediaProbe.h"
+
 #include <filesystem>
+#include <iostream>
 
 extern "C" {
 #include <libavformat/avformat.h>
@@ -12,76 +16,64 @@ bool MetadataEmbedder::WriteMetadataToVideo(
     const std::string& videoPath,
     const VideoInfo& info) {
 
-    const auto metadata = VideoInfoToTags(info);
+    return WriteTags(videoPath, VideoInfoToTags(info));
+}
+
+bool MetadataEmbedder::WriteTags(
+    const std::string& videoPath,
+    const std::map<std::string, std::string>& tags) {
+
+    // Patch the container header in place; only remux when that isn't possible
+    switch (ContainerPatcher::WriteTags(videoPath, tags)) {
+        case ContainerPatcher::Result::Patched:      return true;
+        case ContainerPatcher::Result::Failed:       return false;
+        case ContainerPatcher::Result::NotPatchable: break;
+    }
+
+    std::cout << "[MetadataEmbedder] Cannot patch " << videoPath << " in place, remuxing" << std::endl;
 
-    if (const std::string tempPath = videoPath + ".temp.mp4"; CopyVideoWithNewMetadata(videoPath, tempPath, metadata)) {
+    const std::string tempPath = videoPath + ".temp" + fs::path(videoPath).extension().string();
+    if (CopyVideoWithNewMetadata(videoPath, tempPath, tags)) {
         fs::remove(videoPath);
         fs::rename(tempPath, videoPath);
         return true;
-    } else {
-        if (fs::exists(tempPath)) {
-            fs::remove(tempPath);
-        }
-        return false;
     }
+
+    if (fs::exists(tempPath)) {
+        fs::remove(tempPath);
+    }
+    return false;
 }
 
 bool MetadataEmbedder::ReadMetadataFromVideo(
     const std::string& videoPath,
     VideoInfo& info) {
 
-    AVFormatContext* formatCtx = nullptr;
-
-    if (avformat_open_input(&formatCtx, videoPath.c_str(), nullptr, nullptr) != 0) {
-        return false;
-    }
-
-    avformat_find_stream_info(formatCtx, nullptr);
-
-    const AVDictionaryEntry* tag = nullptr;
-    std::map<std::string, std::string> tags;
-
-    while ((tag = av_dict_get(formatCtx->metadata, "", tag, AV_DICT_IGNORE_SUFFIX))) {
-        tags[tag->key] = tag->value;
-    }
-
-    for (unsigned int i = 0; i < formatCtx->nb_streams; i++) {
-        if (formatCtx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
-            const AVStream* stream = formatCtx->streams[i];
+    const MediaProbe probe(videoPath);
+    return ReadMetadataFromVideo(probe, info);
+}
 
-            info.resolutionWidth = stream->codecpar->width;
-            info.resolutionHeight = stream->codecpar->height;
-            info.frameRate = stream->avg_frame_rate.num / stream->avg_frame_rate.den;
+bool MetadataEmbedder::ReadMetadataFromVideo(
+    const MediaProbe& probe,
+    VideoInfo& info) {
 
-            if (stream->duration != AV_NOPTS_VALUE) {
-                info.durationSec = stream->duration * av_q2d(stream->time_base);
-            }
-            break;
-        }
+    if (!probe.IsOpen()) {
+        return false;
     }
 
-    avformat_close_input(&formatCtx);
-
-    TagsToVideoInfo(tags, info);
-
-    info.filePath = videoPath;
-    info.filePathString = videoPath;
+    probe.FillVideoInfo(info);
+    TagsToVideoInfo(probe.GetTags(), info);
 
-    return !tags.empty();
+    return !probe.GetTags().empty();
 }
 
 bool MetadataEmbedder::HasEmbeddedMetadata(const std::string& videoPath) {
-    AVFormatContext* formatCtx = nullptr;
-
-    if (avformat_open_input(&formatCtx, videoPath.c_str(), nullptr, nullptr) != 0) {
-        return false;
-    }
-
-    const AVDictionaryEntry* tag = av_dict_get(formatCtx->metadata, "app_version", nullptr, 0);
-    const bool hasMetadata = (tag != nullptr);
+    const MediaProbe probe(videoPath, false);
+    return HasEmbeddedMetadata(probe);
+}
 
-    avformat_close_input(&formatCtx);
-    return hasMetadata;
+bool MetadataEmbedder::HasEmbeddedMetadata(const MediaProbe& probe) {
+    return probe.HasTag("app_version");
 }
 
 bool MetadataEmbedder::CopyVideoWithNewMetadata(
@@ -130,7 +122,11 @@ bool MetadataEmbedder::CopyVideoWithNewMetadata(
         }
     }
 
-    avformat_write_header(outputCtx, nullptr);
+    // Without use_metadata_tags the MP4 muxer drops every non-iTunes key
+    AVDictionary* options = nullptr;
+    av_dict_set(&options, "movflags", "use_metadata_tags", 0);
+    avformat_write_header(outputCtx, &options);
+    av_dict_free(&options);
 
     AVPacket packet;
     while (av_read_frame(inputCtx, &packet) >= 0) {
@@ -167,7 +163,7 @@ std::map<std::string, std::string> MetadataEmbedder::VideoInfoToTags(const Video
     std::map<std::string, std::string> tags;
 
     tags["title"]          = info.name;
-    tags["app_version"]    = info.appVersion.empty() ? "0.0.1" : info.appVersion;
+    tags["app_version"]    = info.appVersion.empty() ? DEFAULT_APP_VERSION : info.appVersion;
     tags["clip_start"]     = std::to_string(info.clipStartPoint);
     tags["clip_end"]       = std::to_string(info.clipEndPoint);
     tags["recording_time"] = std::to_string(info.recordingTimeMs);
@@ -217,11 +213,5 @@ bool MetadataEmbedder::AddCustomTag(
     auto tags = VideoInfoToTags(info);
     tags[key] = value;
 
-    if (const std::string tempPath = videoPath + ".temp.mp4"; CopyVideoWithNewMetadata(videoPath, tempPath, tags)) {
-        fs::remove(videoPath);
-        fs::rename(tempPath, videoPath);
-        return true;
-    }
-
-    return false;
-}
\ No newline at end of file
+    return WriteTags(videoPath, tags);
+}
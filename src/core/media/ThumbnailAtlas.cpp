@@ -0,0 +1,419 @@
+#include "core/media/ThumbnailAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/imgutils.h>
+#include <libswscale/swscale.h>
+}
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr const char* kIndexName   = "atlas.idx";
+    constexpr const char* kIndexHeader = "MOMENT_ATLAS";
+    constexpr int         kVersion     = 1;
+
+    // Reads a JPEG file into a decoded frame using an already-open MJPEG decoder
+    AVFrame* DecodeJpeg(AVCodecContext* decoder, const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) return nullptr;
+
+        const auto size = static_cast<int>(file.tellg());
+        if (size <= 0) return nullptr;
+
+        AVPacket* packet = av_packet_alloc();
+        if (av_new_packet(packet, size) < 0) {
+            av_packet_free(&packet);
+            return nullptr;
+        }
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(packet->data), size);
+
+        AVFrame* frame = av_frame_alloc();
+        const bool ok = file
+            && avcodec_send_packet(decoder, packet) == 0
+            && avcodec_receive_frame(decoder, frame) == 0;
+
+        av_packet_free(&packet);
+        if (!ok) av_frame_free(&frame);
+        return frame;
+    }
+
+    bool EncodeJpeg(const AVFrame* frame, const fs::path& outputPath) {
+        const AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_MJPEG);
+        if (!codec) return false;
+
+        AVCodecContext* encoder = avcodec_alloc_context3(codec);
+        encoder->width     = frame->width;
+        encoder->height    = frame->height;
+        encoder->pix_fmt   = AV_PIX_FMT_YUVJ420P;
+        encoder->time_base = {1, 25};
+        encoder->qmin = encoder->qmax = 2;
+
+        AVPacket* packet = av_packet_alloc();
+        bool written = false;
+
+        if (avcodec_open2(encoder, codec, nullptr) >= 0
+            && avcodec_send_frame(encoder, frame) >= 0
+            && avcodec_receive_packet(encoder, packet) >= 0) {
+
+            // Written aside and renamed so a reader never sees half a page
+            const fs::path tmpPath = outputPath.string() + ".tmp";
+            std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(packet->data), packet->size);
+            out.close();
+
+            std::error_code ec;
+            if (out) fs::rename(tmpPath, outputPath, ec);
+            written = out && !ec;
+        }
+
+        av_packet_free(&packet);
+        avcodec_free_context(&encoder);
+        return written;
+    }
+}
+
+ThumbnailAtlas::ThumbnailAtlas(fs::path folder)
+    : m_folder(std::move(folder)) {}
+
+std::string ThumbnailAtlas::TileKey(const std::string& thumbnailPath) {
+    return fs::path(thumbnailPath).filename().string();
+}
+
+int64_t ThumbnailAtlas::ReadMtime(const std::string& path) {
+    std::error_code ec;
+    const auto time = fs::last_write_time(path, ec);
+    return ec ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+fs::path ThumbnailAtlas::GetPagePath(const int page) const {
+    return m_folder / ("atlas_" + std::to_string(page) + ".jpg");
+}
+
+ThumbnailAtlas::UvRect ThumbnailAtlas::GetTileUv(const int slot) {
+    const int column = slot % kColumns;
+    const int row    = slot / kColumns;
+
+    UvRect uv;
+    uv.u0 = static_cast<float>(column)     / kColumns;
+    uv.v0 = static_cast<float>(row)        / kRows;
+    uv.u1 = static_cast<float>(column + 1) / kColumns;
+    uv.v1 = static_cast<float>(row + 1)    / kRows;
+    return uv;
+}
+
+std::optional<ThumbnailAtlas::Tile> ThumbnailAtlas::Find(const std::string& thumbnailPath, const bool checkSource) const {
+    std::lock_guard lock(m_mutex);
+    const auto it = m_tiles.find(TileKey(thumbnailPath));
+    if (it == m_tiles.end()) return std::nullopt;
+
+    // Regenerated since the last pack: the loose file is newer than the tile
+    if (checkSource && it->second.sourceMtime != ReadMtime(thumbnailPath)) return std::nullopt;
+    return it->second;
+}
+
+// ─── Index ───────────────────────────────────────────────────────────────────
+
+bool ThumbnailAtlas::Load() {
+    std::lock_guard lock(m_mutex);
+    return LoadIndex();
+}
+
+bool ThumbnailAtlas::LoadIndex() {
+    m_tiles.clear();
+    m_pageCount = 0;
+    m_indexLoaded = false;
+
+    std::ifstream in(m_folder / kIndexName);
+    if (!in) return false;
+
+    std::string header;
+    int version = 0, tileWidth = 0, tileHeight = 0, columns = 0, rows = 0;
+    in >> header >> version >> tileWidth >> tileHeight >> columns >> rows;
+
+    // A different layout means every page is stale; start over
+    if (header != kIndexHeader || version != kVersion
+        || tileWidth != kTileWidth || tileHeight != kTileHeight
+        || columns != kColumns || rows != kRows) {
+        return false;
+    }
+
+    std::string line;
+    std::getline(in, line);
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        Tile tile;
+        std::string key;
+        fields >> tile.page >> tile.slot >> tile.sourceMtime;
+        fields.get();                  // single separator; names may contain spaces
+        std::getline(fields, key);
+
+        if (tile.page < 0 || tile.slot < 0 || tile.slot >= kTilesPerPage || key.empty())
+            continue;
+        m_pageCount = std::max(m_pageCount, tile.page + 1);
+        m_tiles[key] = tile;   // a later line (see AppendIndex) wins
+    }
+    m_indexLoaded = true;
+    return true;
+}
+
+bool ThumbnailAtlas::SaveIndex() {
+    const fs::path indexPath = m_folder / kIndexName;
+    const fs::path tmpPath   = indexPath.string() + ".tmp";
+
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        if (!out) return false;
+
+        out << kIndexHeader << ' ' << kVersion << ' '
+            << kTileWidth << ' ' << kTileHeight << ' '
+            << kColumns << ' ' << kRows << '\n';
+
+        for (const auto& [key, tile] : m_tiles) {
+            out << tile.page << ' ' << tile.slot << ' ' << tile.sourceMtime << ' ' << key << '\n';
+        }
+        if (!out) return false;
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, indexPath, ec);
+    m_indexLoaded = !ec;
+    return !ec;
+}
+
+bool ThumbnailAtlas::AppendIndex(const std::string& key, const Tile& tile) const {
+    // A torn last line fails to parse and is skipped; the next Sync rewrites it
+    std::ofstream out(m_folder / kIndexName, std::ios::app);
+    out << tile.page << ' ' << tile.slot << ' ' << tile.sourceMtime << ' ' << key << '\n';
+    return static_cast<bool>(out);
+}
+
+// ─── Packing ─────────────────────────────────────────────────────────────────
+
+bool ThumbnailAtlas::Sync(const std::vector<std::string>& thumbnailPaths) {
+    std::lock_guard lock(m_mutex);
+    LoadIndex();
+
+    // key → source file, in library order so new tiles fill pages predictably
+    std::unordered_map<std::string, std::string> sources;
+    std::vector<std::string> order;
+    for (const auto& path : thumbnailPaths) {
+        if (path.empty()) continue;
+        std::string key = TileKey(path);
+        if (sources.emplace(key, path).second) order.push_back(std::move(key));
+    }
+
+    // Forget tiles whose thumbnail is gone; their slots get reused below
+    std::erase_if(m_tiles, [&](const auto& entry) { return !sources.contains(entry.first); });
+
+    std::vector<std::vector<bool>> occupied(m_pageCount, std::vector<bool>(kTilesPerPage, false));
+    for (const auto& [key, tile] : m_tiles) occupied[tile.page][tile.slot] = true;
+
+    std::vector<bool> dirty(m_pageCount, false);
+    for (int page = 0; page < m_pageCount; page++) {
+        if (!fs::exists(GetPagePath(page))) dirty[page] = true;
+    }
+
+    size_t nextPage = 0;
+    for (const auto& key : order) {
+        const int64_t mtime = ReadMtime(sources[key]);
+        if (mtime == 0) {
+            m_tiles.erase(key);
+            continue;
+        }
+
+        if (auto it = m_tiles.find(key); it != m_tiles.end()) {
+            if (it->second.sourceMtime != mtime) {
+                it->second.sourceMtime = mtime;
+                dirty[it->second.page] = true;
+            }
+            continue;
+        }
+
+        // First free slot, appending a page when all are full
+        Tile tile;
+        tile.sourceMtime = mtime;
+        while (tile.slot < 0 && nextPage < occupied.size()) {
+            const auto& slots = occupied[nextPage];
+            const auto free = std::find(slots.begin(), slots.end(), false);
+            if (free == slots.end()) {
+                nextPage++;
+                continue;
+            }
+            tile.page = static_cast<int>(nextPage);
+            tile.slot = static_cast<int>(free - slots.begin());
+        }
+        if (tile.slot < 0) {
+            occupied.emplace_back(kTilesPerPage, false);
+            dirty.push_back(false);
+            tile.page = static_cast<int>(occupied.size()) - 1;
+            tile.slot = 0;
+        }
+
+        occupied[tile.page][tile.slot] = true;
+        dirty[tile.page] = true;
+        m_tiles[key] = tile;
+    }
+
+    // Pages left with no tiles are dropped from the end
+    m_pageCount = 0;
+    for (const auto& [key, tile] : m_tiles) m_pageCount = std::max(m_pageCount, tile.page + 1);
+    for (int page = m_pageCount; page < static_cast<int>(occupied.size()); page++) {
+        std::error_code ec;
+        fs::remove(GetPagePath(page), ec);
+    }
+
+    bool success = true;
+    int rebuilt = 0;
+    for (int page = 0; page < m_pageCount; page++) {
+        if (!dirty[page]) continue;
+        if (RebuildPage(page, sources)) {
+            rebuilt++;
+        } else {
+            // Unpacked tiles fall back to their loose JPEGs
+            std::erase_if(m_tiles, [page](const auto& entry) { return entry.second.page == page; });
+            success = false;
+        }
+    }
+
+    if (rebuilt > 0) {
+        std::cout << "[ThumbnailAtlas] Repacked " << rebuilt << " of "
+                  << m_pageCount << " page(s), " << m_tiles.size() << " tiles" << std::endl;
+    }
+
+    return SaveIndex() && success;
+}
+
+bool ThumbnailAtlas::Update(const std::string& thumbnailPath) {
+    std::lock_guard lock(m_mutex);
+
+    const int64_t mtime = ReadMtime(thumbnailPath);
+    if (mtime == 0) return false;
+
+    // Read once; after that this instance is the one keeping atlas.idx current
+    const bool indexValid = m_indexLoaded || LoadIndex();
+
+    const std::string key = TileKey(thumbnailPath);
+    Tile tile;
+    if (const auto it = m_tiles.find(key); it != m_tiles.end()) {
+        if (it->second.sourceMtime == mtime) return true;
+        tile = it->second;
+    } else {
+        // First free slot, or the start of a new page
+        std::vector<std::vector<bool>> occupied(m_pageCount, std::vector<bool>(kTilesPerPage, false));
+        for (const auto& [other, placed] : m_tiles) occupied[placed.page][placed.slot] = true;
+
+        for (int page = 0; page < m_pageCount && tile.slot < 0; page++) {
+            const auto free = std::find(occupied[page].begin(), occupied[page].end(), false);
+            if (free == occupied[page].end()) continue;
+            tile.page = page;
+            tile.slot = static_cast<int>(free - occupied[page].begin());
+        }
+        if (tile.slot < 0) {
+            tile.page = m_pageCount;
+            tile.slot = 0;
+        }
+    }
+    tile.sourceMtime = mtime;
+    m_tiles[key]     = tile;
+    m_pageCount      = std::max(m_pageCount, tile.page + 1);
+
+    // The page's other tiles come from their loose files next to the atlas
+    std::unordered_map<std::string, std::string> sources;
+    for (const auto& [other, placed] : m_tiles) {
+        if (placed.page == tile.page) sources.emplace(other, (m_folder / other).string());
+    }
+    sources[key] = thumbnailPath;
+
+    if (!RebuildPage(tile.page, sources)) {
+        std::erase_if(m_tiles, [&tile](const auto& entry) { return entry.second.page == tile.page; });
+        SaveIndex();
+        return false;
+    }
+    return indexValid ? AppendIndex(key, tile) : SaveIndex();
+}
+
+bool ThumbnailAtlas::RebuildPage(const int page,
+                                 const std::unordered_map<std::string, std::string>& sources) const {
+    const AVCodec* codec = avcodec_find_decoder(AV_CODEC_ID_MJPEG);
+    if (!codec) return false;
+
+    AVCodecContext* decoder = avcodec_alloc_context3(codec);
+    if (avcodec_open2(decoder, codec, nullptr) < 0) {
+        avcodec_free_context(&decoder);
+        return false;
+    }
+
+    AVFrame* pageFrame = av_frame_alloc();
+    pageFrame->format = AV_PIX_FMT_YUVJ420P;
+    pageFrame->width  = kPageWidth;
+    pageFrame->height = kPageHeight;
+    if (av_frame_get_buffer(pageFrame, 0) < 0) {
+        av_frame_free(&pageFrame);
+        avcodec_free_context(&decoder);
+        return false;
+    }
+
+    // Empty slots stay black
+    for (int y = 0; y < kPageHeight; y++)
+        std::memset(pageFrame->data[0] + y * pageFrame->linesize[0], 0, kPageWidth);
+    for (int plane = 1; plane <= 2; plane++)
+        for (int y = 0; y < kPageHeight / 2; y++)
+            std::memset(pageFrame->data[plane] + y * pageFrame->linesize[plane], 128, kPageWidth / 2);
+
+    SwsContext* swsCtx = nullptr;
+
+    for (const auto& [key, tile] : m_tiles) {
+        if (tile.page != page) continue;
+
+        const auto source = sources.find(key);
+        if (source == sources.end()) continue;
+
+        AVFrame* decoded = DecodeJpeg(decoder, source->second);
+        if (!decoded) {
+            std::cerr << "[ThumbnailAtlas] Failed to decode: " << source->second << std::endl;
+            continue;
+        }
+
+        swsCtx = sws_getCachedContext(
+            swsCtx,
+            decoded->width, decoded->height, static_cast<AVPixelFormat>(decoded->format),
+            kTileWidth, kTileHeight, AV_PIX_FMT_YUVJ420P,
+            SWS_BILINEAR, nullptr, nullptr, nullptr
+        );
+
+        if (swsCtx) {
+            // Scale straight into the tile's rectangle of the page
+            const int x = (tile.slot % kColumns) * kTileWidth;
+            const int y = (tile.slot / kColumns) * kTileHeight;
+
+            uint8_t* dst[4] = {
+                pageFrame->data[0] + y * pageFrame->linesize[0] + x,
+                pageFrame->data[1] + (y / 2) * pageFrame->linesize[1] + x / 2,
+                pageFrame->data[2] + (y / 2) * pageFrame->linesize[2] + x / 2,
+                nullptr
+            };
+            const int dstStride[4] = {
+                pageFrame->linesize[0], pageFrame->linesize[1], pageFrame->linesize[2], 0
+            };
+
+            sws_scale(swsCtx, decoded->data, decoded->linesize, 0, decoded->height, dst, dstStride);
+        }
+
+        av_frame_free(&decoded);
+    }
+
+    const bool written = EncodeJpeg(pageFrame, GetPagePath(page));
+
+    sws_freeContext(swsCtx);
+    av_frame_free(&pageFrame);
+    avcodec_free_context(&decoder);
+    return written;
+}
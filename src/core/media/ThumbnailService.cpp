@@ -1,13 +1,27 @@
 #include "core/media/ThumbnailService.h"
+#include "core/media/HwDecoder.h"
+#include "core/media/MediaProbe.h"
 
 #include <algorithm>
 #include <ctime>
 #include <cstdlib>
 #include <iostream>
+#include <thread>
 #include <vector>
 
 ThumbnailService::ThumbnailService(const std::string& thumbFolder)
     : thumbnailFolder(thumbFolder) {
+
+    // Half the cores run jobs; each job's decoder gets a share of the rest
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    workerCount        = std::clamp<size_t>(cores / 2, 1, 8);
+    codecThreadsPerJob = static_cast<int>(std::max<size_t>(1, cores / workerCount));
+    workerPool         = std::make_unique<ThreadPool>(workerCount);
+}
+
+ThumbnailService::~ThumbnailService() {
+    CancelPending();
+    workerPool.reset();
 }
 
 std::string ThumbnailService::GenerateThumbnail(
@@ -15,6 +29,44 @@ std::string ThumbnailService::GenerateThumbnail(
     const ThumbnailStrategy strategy,
     const int thumbnailWidth,
     const int thumbnailHeight) const {
+    return GenerateThumbnailInternal(videoPath, strategy, thumbnailWidth, thumbnailHeight, 0);
+}
+
+std::vector<ThumbnailJob> ThumbnailService::SubmitBatch(
+    const std::vector<std::string>& videoPaths,
+    const ThumbnailStrategy strategy,
+    const int thumbnailWidth,
+    const int thumbnailHeight) {
+
+    const uint64_t generation = batchGeneration.load();
+    std::vector<ThumbnailJob> jobs;
+    jobs.reserve(videoPaths.size());
+
+    for (const auto& videoPath : videoPaths) {
+        ThumbnailJob job;
+        job.videoPath     = videoPath;
+        job.thumbnailPath = workerPool->Submit(
+            [this, videoPath, strategy, thumbnailWidth, thumbnailHeight, generation]() -> std::string {
+                if (batchGeneration.load() != generation) return "";
+                return GenerateThumbnailInternal(videoPath, strategy,
+                                                 thumbnailWidth, thumbnailHeight,
+                                                 codecThreadsPerJob);
+            });
+        jobs.push_back(std::move(job));
+    }
+    return jobs;
+}
+
+void ThumbnailService::CancelPending() {
+    ++batchGeneration;
+}
+
+std::string ThumbnailService::GenerateThumbnailInternal(
+    const std::string& videoPath,
+    const ThumbnailStrategy strategy,
+    const int thumbnailWidth,
+    const int thumbnailHeight,
+    const int codecThreads) const {
 
     // Thumbnail path create
     std::string thumbnailPath = GetThumbnailPath(videoPath);
@@ -23,49 +75,79 @@ std::string ThumbnailService::GenerateThumbnail(
         return thumbnailPath;
     }
 
-    // Open video folder
-    AVFormatContext* formatCtx = nullptr;
-    if (avformat_open_input(&formatCtx, videoPath.c_str(), nullptr, nullptr) != 0) {
-        return "";
-    }
+    const MediaProbe probe(videoPath);
+    return ExtractThumbnail(probe, thumbnailPath, strategy, thumbnailWidth, thumbnailHeight, codecThreads)
+        ? thumbnailPath : "";
+}
 
-    // Stream info
-    if (avformat_find_stream_info(formatCtx, nullptr) < 0) {
-        avformat_close_input(&formatCtx);
-        return "";
-    }
+std::string ThumbnailService::GenerateThumbnail(
+    const MediaProbe& probe,
+    const ThumbnailStrategy strategy,
+    const int thumbnailWidth,
+    const int thumbnailHeight) const {
 
-    // Find video stream
-    int videoStreamIndex = -1;
-    const AVCodecParameters* codecParams = nullptr;
+    std::string thumbnailPath = GetThumbnailPath(probe.GetPath());
 
-    for (unsigned int i = 0; i < formatCtx->nb_streams; i++) {
-        if (formatCtx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
-            videoStreamIndex = i;
-            codecParams = formatCtx->streams[i]->codecpar;
-            break;
-        }
+    if (fs::exists(thumbnailPath)) {
+        return thumbnailPath;
     }
 
-    if (videoStreamIndex == -1) {
-        avformat_close_input(&formatCtx);
-        return "";
+    // Callers may run several of these at once (import pipeline): take a job's share of cores
+    return ExtractThumbnail(probe, thumbnailPath, strategy, thumbnailWidth, thumbnailHeight, codecThreadsPerJob)
+        ? thumbnailPath : "";
+}
+
+bool ThumbnailService::ExtractThumbnail(
+    const MediaProbe& probe,
+    const std::string& thumbnailPath,
+    const ThumbnailStrategy strategy,
+    const int thumbnailWidth,
+    const int thumbnailHeight,
+    const int codecThreads) {
+
+    if (!probe.HasVideo()) {
+        return false;
     }
 
+    AVFormatContext* formatCtx = probe.GetFormatContext();
+    const int videoStreamIndex = probe.GetVideoStreamIndex();
+    const AVCodecParameters* codecParams = formatCtx->streams[videoStreamIndex]->codecpar;
+
     // Open codec
     const AVCodec* codec = avcodec_find_decoder(codecParams->codec_id);
     if (!codec) {
-        avformat_close_input(&formatCtx);
-        return "";
+        return false;
     }
 
+    // Keyframe-only: the decoder drops everything else, and slice threading avoids
+    // frame threading's pipeline delay (which would need N keyframes before output)
+    const bool keyframeOnly = strategy == ThumbnailStrategy::KEYFRAME_NEAR_1SEC;
+    const auto configureCodec = [&](AVCodecContext* ctx) {
+        avcodec_parameters_to_context(ctx, codecParams);
+        ctx->thread_count = codecThreads;   // 0 = let FFmpeg use every core
+        if (keyframeOnly) {
+            ctx->skip_frame  = AVDISCARD_NONKEY;
+            ctx->thread_type = FF_THREAD_SLICE;
+        }
+    };
+
     AVCodecContext* codecCtx = avcodec_alloc_context3(codec);
-    avcodec_parameters_to_context(codecCtx, codecParams);
+    configureCodec(codecCtx);
+
+    // Decode on the GPU when possible; fall back to software if the device won't open
+    int openResult = -1;
+    if (HwDecoder::Attach(codecCtx, codec)) {
+        openResult = avcodec_open2(codecCtx, codec, nullptr);
+        if (openResult < 0) {
+            avcodec_free_context(&codecCtx);
+            codecCtx = avcodec_alloc_context3(codec);
+            configureCodec(codecCtx);
+        }
+    }
 
-    if (avcodec_open2(codecCtx, codec, nullptr) < 0) {
+    if (openResult < 0 && avcodec_open2(codecCtx, codec, nullptr) < 0) {
         avcodec_free_context(&codecCtx);
-        avformat_close_input(&formatCtx);
-        return "";
+        return false;
     }
 
     const int64_t targetPts = CalculateTargetPts(formatCtx, videoStreamIndex, strategy);
@@ -73,14 +155,13 @@ std::string ThumbnailService::GenerateThumbnail(
     const bool success = ExtractFrame(
         formatCtx, codecCtx, videoStreamIndex,
         targetPts, thumbnailPath,
-        thumbnailWidth, thumbnailHeight
+        thumbnailWidth, thumbnailHeight, keyframeOnly
     );
 
-    // Cleaning
+    // The format context belongs to the probe
     avcodec_free_context(&codecCtx);
-    avformat_close_input(&formatCtx);
 
-    return success ? thumbnailPath : "";
+    return success;
 }
 
 std::string ThumbnailService::GetThumbnailPath(const std::string& videoPath) const {
@@ -138,6 +219,7 @@ int64_t ThumbnailService::CalculateTargetPts(
             break;
 
         case ThumbnailStrategy::SMART_FRAME:
+        case ThumbnailStrategy::KEYFRAME_NEAR_1SEC:
             targetPts = av_rescale_q(
                 1 * AV_TIME_BASE,
                 {1, AV_TIME_BASE},
@@ -160,18 +242,25 @@ bool ThumbnailService::ExtractFrame(
     const int64_t targetPts,
     const std::string& outputPath,
     const int thumbnailWidth,
-    const int thumbnailHeight) {
+    const int thumbnailHeight,
+    const bool keyframeOnly) {
 
     av_seek_frame(formatCtx, videoStreamIndex, targetPts, AVSEEK_FLAG_BACKWARD);
     avcodec_flush_buffers(codecCtx);
 
-    AVFrame* frame = DecodeFrame(formatCtx, codecCtx, videoStreamIndex, targetPts);
+    AVFrame* frame = DecodeFrame(formatCtx, codecCtx, videoStreamIndex, targetPts, keyframeOnly);
     if (!frame) {
         return false;
     }
 
-    const bool success = SaveFrameAsJPEG(frame, outputPath, thumbnailWidth, thumbnailHeight);
+    // VAAPI surfaces have to come back to system memory before scaling
+    AVFrame* swFrame = av_frame_alloc();
+    const AVFrame* source = HwDecoder::Download(frame, swFrame);
+
+    const bool success = source
+        && SaveFrameAsJPEG(const_cast<AVFrame*>(source), outputPath, thumbnailWidth, thumbnailHeight);
 
+    av_frame_free(&swFrame);
     av_frame_free(&frame);
     return success;
 }
@@ -180,108 +269,151 @@ AVFrame* ThumbnailService::DecodeFrame(
     AVFormatContext* formatCtx,
     AVCodecContext* codecCtx,
     const int videoStreamIndex,
-    const int64_t targetPts) {
+    const int64_t targetPts,
+    const bool keyframeOnly) {
 
     AVPacket* packet = av_packet_alloc();
     AVFrame* frame = av_frame_alloc();
     AVFrame* targetFrame = nullptr;
 
-    while (av_read_frame(formatCtx, packet) >= 0) {
-        if (packet->stream_index == videoStreamIndex) {
-            if (avcodec_send_packet(codecCtx, packet) == 0) {
-                while (avcodec_receive_frame(codecCtx, frame) == 0) {
-                    if (frame->pts >= targetPts) {
-                        targetFrame = av_frame_clone(frame);
-                        av_packet_unref(packet);
-                        goto cleanup;
-                    }
+    // Keyframe-only takes whatever the seek landed on; otherwise decode up to the target
+    const auto accept = [&]() {
+        return keyframeOnly || frame->pts >= targetPts;
+    };
+
+    while (!targetFrame && av_read_frame(formatCtx, packet) >= 0) {
+        const bool wanted = packet->stream_index == videoStreamIndex
+                         && (!keyframeOnly || (packet->flags & AV_PKT_FLAG_KEY));
+
+        if (wanted && avcodec_send_packet(codecCtx, packet) == 0) {
+            while (avcodec_receive_frame(codecCtx, frame) == 0) {
+                if (accept()) {
+                    targetFrame = av_frame_clone(frame);
+                    break;
                 }
             }
         }
         av_packet_unref(packet);
     }
 
-cleanup:
+    // Short clips can hit EOF with the frame still buffered in the decoder
+    if (!targetFrame && avcodec_send_packet(codecCtx, nullptr) == 0) {
+        while (!targetFrame && avcodec_receive_frame(codecCtx, frame) == 0) {
+            if (accept()) targetFrame = av_frame_clone(frame);
+        }
+    }
+
     av_packet_free(&packet);
     av_frame_free(&frame);
 
     return targetFrame;
 }
 
+namespace {
+    // Scaler + MJPEG encoder reused across thumbnails on the same thread.
+    // Pool workers live for the whole session, so setup is paid once per worker
+    // and per (source format, source size, thumbnail size) combination.
+    struct JpegEncoderCache {
+        SwsContext*     swsCtx    = nullptr;   // sws_getCachedContext keys on fmt + sizes
+        AVCodecContext* jpegCtx   = nullptr;
+        AVFrame*        yuvFrame  = nullptr;
+        AVPacket*       packet    = nullptr;
+        int             dstWidth  = 0;
+        int             dstHeight = 0;
+
+        ~JpegEncoderCache() {
+            sws_freeContext(swsCtx);
+            avcodec_free_context(&jpegCtx);
+            av_frame_free(&yuvFrame);
+            av_packet_free(&packet);
+        }
+
+        bool PrepareEncoder(const int width, const int height) {
+            if (jpegCtx && dstWidth == width && dstHeight == height) return true;
+
+            avcodec_free_context(&jpegCtx);
+            av_frame_free(&yuvFrame);
+
+            const AVCodec* jpegCodec = avcodec_find_encoder(AV_CODEC_ID_MJPEG);
+            if (!jpegCodec) return false;
+
+            jpegCtx = avcodec_alloc_context3(jpegCodec);
+            if (!jpegCtx) return false;
+            jpegCtx->width     = width;
+            jpegCtx->height    = height;
+            jpegCtx->pix_fmt   = AV_PIX_FMT_YUVJ420P;
+            jpegCtx->time_base = {1, 25};
+            jpegCtx->qmin = jpegCtx->qmax = 2;
+
+            if (avcodec_open2(jpegCtx, jpegCodec, nullptr) < 0) {
+                avcodec_free_context(&jpegCtx);
+                return false;
+            }
+
+            yuvFrame = av_frame_alloc();
+            yuvFrame->format = AV_PIX_FMT_YUVJ420P;
+            yuvFrame->width  = width;
+            yuvFrame->height = height;
+            if (av_frame_get_buffer(yuvFrame, 0) < 0) {
+                avcodec_free_context(&jpegCtx);
+                av_frame_free(&yuvFrame);
+                return false;
+            }
+
+            if (!packet) packet = av_packet_alloc();
+            dstWidth  = width;
+            dstHeight = height;
+            return true;
+        }
+    };
+
+    thread_local JpegEncoderCache t_jpegCache;
+}
+
 bool ThumbnailService::SaveFrameAsJPEG(
     AVFrame* frame,
     const std::string& outputPath,
     const int width,
     const int height) {
 
-    SwsContext* swsCtx = sws_getContext(
+    JpegEncoderCache& cache = t_jpegCache;
+    if (!cache.PrepareEncoder(width, height)) {
+        return false;
+    }
+
+    // Straight from the decoder's format to the encoder's, no RGB round-trip
+    cache.swsCtx = sws_getCachedContext(
+        cache.swsCtx,
         frame->width, frame->height, static_cast<AVPixelFormat>(frame->format),
-        width, height, AV_PIX_FMT_RGB24,
+        width, height, AV_PIX_FMT_YUVJ420P,
         SWS_BILINEAR, nullptr, nullptr, nullptr
     );
 
-    if (!swsCtx) {
+    if (!cache.swsCtx) {
         return false;
     }
 
-    AVFrame* rgbFrame = av_frame_alloc();
-    rgbFrame->format = AV_PIX_FMT_RGB24;
-    rgbFrame->width = width;
-    rgbFrame->height = height;
-
-    av_frame_get_buffer(rgbFrame, 0);
+    // The encoder may still reference last call's buffer
+    if (av_frame_make_writable(cache.yuvFrame) < 0) {
+        return false;
+    }
 
     sws_scale(
-        swsCtx,
+        cache.swsCtx,
         frame->data, frame->linesize, 0, frame->height,
-        rgbFrame->data, rgbFrame->linesize
+        cache.yuvFrame->data, cache.yuvFrame->linesize
     );
 
-    // JPEG encoder
-    const AVCodec* jpegCodec = avcodec_find_encoder(AV_CODEC_ID_MJPEG);
-    AVCodecContext* jpegCtx = avcodec_alloc_context3(jpegCodec);
-
-    jpegCtx->width = width;
-    jpegCtx->height = height;
-    jpegCtx->pix_fmt = AV_PIX_FMT_YUVJ420P;
-    jpegCtx->time_base = {1, 25};
-    jpegCtx->qmin = jpegCtx->qmax = 2;
-
-    avcodec_open2(jpegCtx, jpegCodec, nullptr);
-
-    SwsContext* swsCtx2 = sws_getContext(
-        width, height, AV_PIX_FMT_RGB24,
-        width, height, AV_PIX_FMT_YUVJ420P,
-        SWS_BILINEAR, nullptr, nullptr, nullptr
-    );
-
-    AVFrame* yuvFrame = av_frame_alloc();
-    yuvFrame->format = AV_PIX_FMT_YUVJ420P;
-    yuvFrame->width = width;
-    yuvFrame->height = height;
-    av_frame_get_buffer(yuvFrame, 0);
-
-    sws_scale(
-        swsCtx2,
-        rgbFrame->data, rgbFrame->linesize, 0, height,
-        yuvFrame->data, yuvFrame->linesize
-    );
-
-    AVPacket* packet = av_packet_alloc();
-    avcodec_send_frame(jpegCtx, yuvFrame);
-    avcodec_receive_packet(jpegCtx, packet);
-
-    if (FILE* file = fopen(outputPath.c_str(), "wb")) {
-        fwrite(packet->data, 1, packet->size, file);
-        fclose(file);
+    bool written = false;
+    if (avcodec_send_frame(cache.jpegCtx, cache.yuvFrame) >= 0
+        && avcodec_receive_packet(cache.jpegCtx, cache.packet) >= 0) {
+        if (FILE* file = fopen(outputPath.c_str(), "wb")) {
+            written = fwrite(cache.packet->data, 1, cache.packet->size, file)
+                      == static_cast<size_t>(cache.packet->size);
+            fclose(file);
+        }
+        av_packet_unref(cache.packet);
     }
 
-    av_packet_free(&packet);
-    av_frame_free(&yuvFrame);
-    av_frame_free(&rgbFrame);
-    avcodec_free_context(&jpegCtx);
-    sws_freeContext(swsCtx);
-    sws_freeContext(swsCtx2);
-
-    return true;
+    return written;
 }
@@ -1,7 +1,12 @@
 #include "core/media/VideoPlayer.h"
+#include "core/ProjectPaths.h"
+#include "core/media/HwDecoder.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
-#include <glad/glad.h>
+
+namespace fs = std::filesystem;
 
 VideoPlayer::~VideoPlayer() {
     Cleanup();
@@ -31,6 +36,12 @@ bool VideoPlayer::LoadVideo(const std::string& filePath) {
 
     m_videoStream = m_formatCtx->streams[m_videoStreamIndex];
 
+    // The demuxer only has to hand us video packets
+    for (unsigned int i = 0; i < m_formatCtx->nb_streams; i++) {
+        if (static_cast<int>(i) != m_videoStreamIndex)
+            m_formatCtx->streams[i]->discard = AVDISCARD_ALL;
+    }
+
     const AVCodec* codec = avcodec_find_decoder(m_videoStream->codecpar->codec_id);
     if (!codec) {
         std::cerr << "[VideoPlayer] Codec not found" << std::endl;
@@ -56,7 +67,20 @@ bool VideoPlayer::LoadVideo(const std::string& filePath) {
     if (m_codecCtx->color_range == AVCOL_RANGE_UNSPECIFIED)
         m_codecCtx->color_range = AVCOL_RANGE_MPEG;
 
-    if (avcodec_open2(m_codecCtx, codec, nullptr) < 0) {
+    // VAAPI when configured and available; otherwise (or if opening fails) software
+    const bool hwDecode = HwDecoder::Attach(m_codecCtx, codec);
+    int openResult = avcodec_open2(m_codecCtx, codec, nullptr);
+    if (openResult < 0 && hwDecode) {
+        std::cerr << "[VideoPlayer] Hardware decoder failed to open, retrying in software" << std::endl;
+        avcodec_free_context(&m_codecCtx);
+        m_codecCtx = avcodec_alloc_context3(codec);
+        if (m_codecCtx && avcodec_parameters_to_context(m_codecCtx, m_videoStream->codecpar) >= 0) {
+            if (m_codecCtx->color_range == AVCOL_RANGE_UNSPECIFIED)
+                m_codecCtx->color_range = AVCOL_RANGE_MPEG;
+            openResult = avcodec_open2(m_codecCtx, codec, nullptr);
+        }
+    }
+    if (openResult < 0) {
         std::cerr << "[VideoPlayer] Failed to open codec" << std::endl;
         avcodec_free_context(&m_codecCtx);
         avformat_close_input(&m_formatCtx);
@@ -76,123 +100,296 @@ bool VideoPlayer::LoadVideo(const std::string& filePath) {
               << " @ " << m_frameRate << " fps, duration: " << m_duration << "s"
               << std::endl;
 
-    m_frame    = av_frame_alloc();
-    m_rgbFrame = av_frame_alloc();
-    if (!m_frame || !m_rgbFrame) {
+    m_frame   = av_frame_alloc();
+    m_swFrame = av_frame_alloc();
+    if (!m_frame || !m_swFrame) {
         std::cerr << "[VideoPlayer] Failed to allocate frames" << std::endl;
         Cleanup();
         return false;
     }
 
-    // Use sws_getContext with explicit pixel format; avoids the deprecated-pix-fmt warning
-    // Map the codec pixel format — fall back to yuv420p if unknown
-    AVPixelFormat srcFmt = m_codecCtx->pix_fmt;
-    if (srcFmt == AV_PIX_FMT_NONE) srcFmt = AV_PIX_FMT_YUV420P;
-
-    m_swsCtx = sws_getContext(
-        m_width, m_height, srcFmt,
-        m_width, m_height, AV_PIX_FMT_RGB24,
-        SWS_BILINEAR, nullptr, nullptr, nullptr);
-
-    if (!m_swsCtx) {
-        std::cerr << "[VideoPlayer] Failed to create SWS context" << std::endl;
-        Cleanup();
-        return false;
+    // Ring slots hold references to decoded frames; converted on the GPU at upload
+    for (auto& slot : m_frames) {
+        slot.frame = av_frame_alloc();
+        if (!slot.frame) {
+            std::cerr << "[VideoPlayer] Failed to allocate frames" << std::endl;
+            Cleanup();
+            return false;
+        }
     }
 
-    int bufferSize = av_image_get_buffer_size(AV_PIX_FMT_RGB24, m_width, m_height, 1);
-    m_buffer = static_cast<uint8_t*>(av_malloc(bufferSize));
-    if (!m_buffer) {
-        std::cerr << "[VideoPlayer] Failed to allocate RGB buffer" << std::endl;
+    if (!m_renderer.Init(m_width, m_height)) {
+        std::cerr << "[VideoPlayer] Failed to set up YUV renderer" << std::endl;
         Cleanup();
         return false;
     }
 
-    av_image_fill_arrays(m_rgbFrame->data, m_rgbFrame->linesize,
-                         m_buffer, AV_PIX_FMT_RGB24, m_width, m_height, 1);
+    m_isLoaded          = true;
+    m_currentTime       = 0.0;
+    m_awaitingSeekFrame = true;   // show the first frame even while paused
+
+    StartPipeline();
+
+    // Keyframe index: persisted under .moment/ when the clip lives in a library
+    const fs::path video(filePath);
+    const ProjectPaths paths = ProjectPaths::FromFolder(video.parent_path());
+    const fs::path indexPath = fs::exists(paths.momentFolder)
+                             ? paths.GetKeyframeIndexPath(video)
+                             : fs::path{};
+    m_indexThread = std::thread([this, filePath, indexPath] {
+        if (m_keyframeIndex.LoadOrBuild(filePath, indexPath, m_quit))
+            m_indexReady = true;
+    });
+    return true;
+}
 
-    CreateTexture();
+// ─── Pipeline ────────────────────────────────────────────────────────────────
 
-    m_isLoaded   = true;
-    m_currentTime = 0.0;
-    return true;
+void VideoPlayer::StartPipeline() {
+    m_quit = false;
+    m_demuxThread  = std::thread(&VideoPlayer::DemuxLoop, this);
+    m_decodeThread = std::thread(&VideoPlayer::DecodeLoop, this);
 }
 
-void VideoPlayer::CreateTexture() {
-    if (m_textureId) {
-        glDeleteTextures(1, &m_textureId);
-        m_textureId = 0;
+void VideoPlayer::StopPipeline() {
+    m_quit = true;
+    m_packetCv.notify_all();
+    m_frameCv.notify_all();
+
+    if (m_demuxThread.joinable())  m_demuxThread.join();
+    if (m_decodeThread.joinable()) m_decodeThread.join();
+    if (m_indexThread.joinable())  m_indexThread.join();
+
+    for (auto& queued : m_packets)
+        av_packet_free(&queued.packet);
+    m_packets.clear();
+
+    for (auto& slot : m_frames) {
+        if (slot.frame) av_frame_unref(slot.frame);
     }
+    m_frameRead   = 0;
+    m_frameCount  = 0;
+    m_seekPending = false;
+    m_demuxEof    = false;
+}
 
-    glGenTextures(1, &m_textureId);
-    glBindTexture(GL_TEXTURE_2D, m_textureId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_width, m_height, 0,
-                 GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    std::cout << "[VideoPlayer] Created texture " << m_textureId << std::endl;
+void VideoPlayer::DemuxLoop() {
+    AVPacket* packet = av_packet_alloc();
+    if (!packet) return;
+
+    while (!m_quit) {
+        uint64_t serial;
+        {
+            std::unique_lock lock(m_packetMutex);
+            m_packetCv.wait(lock, [this] {
+                return m_quit || m_seekPending
+                    || (!m_demuxEof && m_packets.size() < kMaxQueuedPackets);
+            });
+            if (m_quit) break;
+
+            if (m_seekPending) {
+                m_seekPending = false;
+                const int64_t timestamp = std::llround(
+                    m_seekTarget / av_q2d(m_videoStream->time_base));
+                lock.unlock();
+                av_seek_frame(m_formatCtx, m_videoStreamIndex, timestamp, AVSEEK_FLAG_BACKWARD);
+                continue;
+            }
+            serial = m_serial;
+        }
+
+        const int ret = av_read_frame(m_formatCtx, packet);
+
+        std::lock_guard lock(m_packetMutex);
+        if (serial != m_serial) {
+            // A seek arrived while we were reading; this packet belongs to the old position
+            av_packet_unref(packet);
+            continue;
+        }
+        if (ret < 0) {
+            m_packets.push_back({nullptr, serial});
+            m_demuxEof = true;
+        } else if (packet->stream_index == m_videoStreamIndex) {
+            AVPacket* queued = av_packet_alloc();
+            av_packet_move_ref(queued, packet);
+            m_packets.push_back({queued, serial});
+        } else {
+            av_packet_unref(packet);
+            continue;
+        }
+        m_packetCv.notify_all();
+    }
+
+    av_packet_free(&packet);
 }
 
-void VideoPlayer::Update(float deltaTime) {
-    if (!m_isLoaded || !m_isPlaying) return;
+void VideoPlayer::DecodeLoop() {
+    uint64_t decoderSerial = 0;
 
-    m_frameAccumulator += deltaTime;
+    while (!m_quit) {
+        QueuedPacket queued;
+        {
+            std::unique_lock lock(m_packetMutex);
+            m_packetCv.wait(lock, [this] { return m_quit || !m_packets.empty(); });
+            if (m_quit) break;
 
-    while (m_frameAccumulator >= m_frameTime && m_isPlaying) {
-        DecodeFrame();
-        m_frameAccumulator -= m_frameTime;
-        m_currentTime      += m_frameTime;
+            queued = m_packets.front();
+            m_packets.pop_front();
+        }
+        m_packetCv.notify_all();   // room for the demuxer
 
-        if (m_currentTime >= m_duration) {
-            m_currentTime = m_duration;
-            m_isPlaying   = false;
+        if (queued.serial != decoderSerial) {
+            avcodec_flush_buffers(m_codecCtx);
+            decoderSerial = queued.serial;
+        }
+
+        // nullptr drains the decoder at end of stream
+        int ret = avcodec_send_packet(m_codecCtx, queued.packet);
+        av_packet_free(&queued.packet);
+        if (ret < 0 && ret != AVERROR(EAGAIN)) continue;
+
+        while (!m_quit && avcodec_receive_frame(m_codecCtx, m_frame) == 0) {
+            // VAAPI surfaces are downloaded here so the ring/cache never pin decoder surfaces
+            const AVFrame* frame = HwDecoder::Download(m_frame, m_swFrame);
+            const bool accepted = !frame || PushDecodedFrame(frame, decoderSerial);
+            av_frame_unref(m_frame);
+            av_frame_unref(m_swFrame);
+            if (!accepted) break;
         }
     }
 }
 
-void VideoPlayer::DecodeFrame() {
+bool VideoPlayer::PushDecodedFrame(const AVFrame* frame, const uint64_t serial) {
+    const int64_t ts = frame->best_effort_timestamp != AV_NOPTS_VALUE
+                     ? frame->best_effort_timestamp
+                     : frame->pts;
+    const double pts = ts != AV_NOPTS_VALUE ? ts * av_q2d(m_videoStream->time_base) : 0.0;
+    m_lastDecodedPts = pts;
+
+    const bool native = YuvRenderer::IsSupported(frame->format);
+    if (native) m_frameCache.Insert(pts, frame);
+
+    // Decoding up to a seek target: keep the frame for later scrubs, but don't show it
+    if (pts < m_decodeTarget - m_frameTime * 0.5) return true;
+
+    size_t slotIndex;
+    {
+        std::unique_lock lock(m_frameMutex);
+        m_frameCv.wait(lock, [this, serial] {
+            return m_quit || m_frameSerial != serial || m_frameCount < kFrameRingSize;
+        });
+        if (m_quit || m_frameSerial != serial) return false;
+        slotIndex = (m_frameRead + m_frameCount) % kFrameRingSize;
+    }
+
+    // The render thread only reads published slots, so the free one can be filled unlocked
+    DecodedFrame& slot = m_frames[slotIndex];
+    slot.pts = pts;
+
+    av_frame_unref(slot.frame);
+    if (YuvRenderer::IsSupported(frame->format)) {
+        // Zero-copy: just keep a reference to the decoder's planes
+        if (av_frame_ref(slot.frame, frame) < 0) return true;
+    } else {
+        // Uncommon layouts (4:2:2, 4:4:4, ...) are squeezed into yuv420p on this thread
+        m_swsCtx = sws_getCachedContext(m_swsCtx,
+            frame->width, frame->height, static_cast<AVPixelFormat>(frame->format),
+            frame->width, frame->height, AV_PIX_FMT_YUV420P,
+            SWS_BILINEAR, nullptr, nullptr, nullptr);
+        if (!m_swsCtx) return true;
+
+        slot.frame->format = AV_PIX_FMT_YUV420P;
+        slot.frame->width  = frame->width;
+        slot.frame->height = frame->height;
+        if (av_frame_get_buffer(slot.frame, 0) < 0) return true;
+        av_frame_copy_props(slot.frame, frame);
+
+        sws_scale(m_swsCtx,
+                  frame->data, frame->linesize, 0, frame->height,
+                  slot.frame->data, slot.frame->linesize);
+        m_frameCache.Insert(pts, slot.frame);
+    }
+
+    std::lock_guard lock(m_frameMutex);
+    if (m_frameSerial != serial) {
+        av_frame_unref(slot.frame);
+        return false;
+    }
+    m_frameCount++;
+    return true;
+}
+
+void VideoPlayer::PopFrame() {
+    {
+        std::lock_guard lock(m_frameMutex);
+        if (m_frameCount == 0) return;
+        av_frame_unref(m_frames[m_frameRead].frame);   // hand the buffer back to the decoder pool
+        m_frameRead = (m_frameRead + 1) % kFrameRingSize;
+        m_frameCount--;
+    }
+    m_frameCv.notify_all();
+}
+
+// ─── Render thread ───────────────────────────────────────────────────────────
+
+void VideoPlayer::Update(float deltaTime) {
     if (!m_isLoaded) return;
 
-    // ✅ Use heap-allocated packet (av_init_packet is removed in FFmpeg 5+)
-    AVPacket* packet = av_packet_alloc();
-    if (!packet) return;
+    if (m_isPlaying) {
+        m_currentTime += deltaTime;
+        if (m_currentTime >= m_duration) {
+            m_currentTime = m_duration;
+            m_isPlaying   = false;
+        }
+    }
 
-    bool decoded = false;
-
-    while (!decoded && av_read_frame(m_formatCtx, packet) >= 0) {
-        if (packet->stream_index == m_videoStreamIndex) {
-            int ret = avcodec_send_packet(m_codecCtx, packet);
-            if (ret >= 0) {
-                ret = avcodec_receive_frame(m_codecCtx, m_frame);
-                if (ret == 0) {
-                    // Convert to RGB
-                    sws_scale(m_swsCtx,
-                              (const uint8_t* const*)m_frame->data,
-                              m_frame->linesize, 0, m_codecCtx->height,
-                              m_rgbFrame->data, m_rgbFrame->linesize);
-
-                    // Upload to GPU texture
-                    glBindTexture(GL_TEXTURE_2D, m_textureId);
-                    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_width, m_height,
-                                   GL_RGB, GL_UNSIGNED_BYTE, m_buffer);
-                    glBindTexture(GL_TEXTURE_2D, 0);
-
-                    decoded = true;
+    // A cached frame is on screen; the pipeline catches up on Play() or the next miss
+    if (m_pipelineStale) return;
+
+    // Pick the newest frame that is due, dropping the ones we are already late for
+    const DecodedFrame* due = nullptr;
+    {
+        std::lock_guard lock(m_frameMutex);
+        while (m_frameCount > 0) {
+            DecodedFrame& front = m_frames[m_frameRead];
+            if (m_awaitingSeekFrame) {
+                // The target may have moved forward within the GOP since these were queued
+                if (front.pts < m_decodeTarget - m_frameTime * 0.5) {
+                    av_frame_unref(front.frame);
+                    m_frameRead = (m_frameRead + 1) % kFrameRingSize;
+                    m_frameCount--;
+                    continue;
                 }
+                due = &front;
+                break;
             }
+            if (front.pts > m_currentTime + m_frameTime * 0.5) break;
+
+            if (m_frameCount > 1) {
+                const DecodedFrame& next = m_frames[(m_frameRead + 1) % kFrameRingSize];
+                if (next.pts <= m_currentTime) {
+                    av_frame_unref(front.frame);
+                    m_frameRead = (m_frameRead + 1) % kFrameRingSize;
+                    m_frameCount--;
+                    continue;
+                }
+            }
+            due = &front;
+            break;
         }
-        av_packet_unref(packet);
     }
+    if (!due) return;
 
-    av_packet_free(&packet);
+    // Slot stays published (so untouched by the decoder) until it is popped below
+    m_renderer.Render(due->frame);
+    m_awaitingSeekFrame = false;
+
+    PopFrame();
 }
 
 void VideoPlayer::Play() {
     if (m_isLoaded) {
+        if (m_pipelineStale) RequestPipelineSeek(m_currentTime);
         m_isPlaying = true;
         std::cout << "[VideoPlayer] Playing" << std::endl;
     }
@@ -204,12 +401,8 @@ void VideoPlayer::Pause() {
 }
 
 void VideoPlayer::Stop() {
-    m_isPlaying        = false;
-    m_currentTime      = 0.0;
-    m_frameAccumulator = 0.0;
-
-    if (m_formatCtx)
-        av_seek_frame(m_formatCtx, m_videoStreamIndex, 0, AVSEEK_FLAG_BACKWARD);
+    Seek(0.0);
+    m_isPlaying = false;
 
     std::cout << "[VideoPlayer] Stopped" << std::endl;
 }
@@ -218,43 +411,92 @@ void VideoPlayer::Seek(double seconds) {
     if (!m_isLoaded) return;
 
     seconds = std::max(0.0, std::min(seconds, m_duration));
+    m_currentTime = seconds;
+
+    // Scrubbing near recently decoded frames: show it now, no decoder round-trip
+    if (!m_isPlaying) {
+        if (AVFrame* cached = m_frameCache.Find(seconds, m_frameTime)) {
+            m_renderer.Render(cached);
+            av_frame_free(&cached);
+            m_awaitingSeekFrame = false;
+            m_pipelineStale     = true;
+            return;
+        }
+    }
+
+    RequestPipelineSeek(seconds);
+}
 
-    int64_t timestamp = static_cast<int64_t>(
-        seconds / av_q2d(m_videoStream->time_base));
+void VideoPlayer::RequestPipelineSeek(const double seconds) {
+    const double keyframe = m_indexReady ? m_keyframeIndex.KeyframeAtOrBefore(seconds) : -1.0;
 
-    if (av_seek_frame(m_formatCtx, m_videoStreamIndex,
-                      timestamp, AVSEEK_FLAG_BACKWARD) >= 0) {
-        avcodec_flush_buffers(m_codecCtx);
-        m_currentTime      = seconds;
-        m_frameAccumulator = 0.0;
-        std::cout << "[VideoPlayer] Seeked to " << seconds << "s" << std::endl;
+    // Same GOP and the decoder hasn't passed the target yet: just move the target
+    if (!m_pipelineStale && keyframe >= 0.0 && keyframe == m_seekKeyframe
+        && seconds >= m_lastDecodedPts) {
+        m_decodeTarget      = seconds;
+        m_awaitingSeekFrame = true;
+        return;
     }
+
+    {
+        std::lock_guard lock(m_packetMutex);
+        for (auto& queued : m_packets)
+            av_packet_free(&queued.packet);
+        m_packets.clear();
+
+        m_serial++;
+        m_seekTarget  = keyframe >= 0.0 ? keyframe : seconds;
+        m_seekPending = true;
+        m_demuxEof    = false;
+
+        std::lock_guard frameLock(m_frameMutex);
+        for (size_t i = 0; i < m_frameCount; i++)
+            av_frame_unref(m_frames[(m_frameRead + i) % kFrameRingSize].frame);
+        m_frameSerial = m_serial;
+        m_frameRead   = 0;
+        m_frameCount  = 0;
+
+        m_decodeTarget   = seconds;
+        m_lastDecodedPts = -1.0;
+    }
+    m_packetCv.notify_all();
+    m_frameCv.notify_all();
+
+    m_seekKeyframe      = keyframe;
+    m_pipelineStale     = false;
+    m_awaitingSeekFrame = true;
 }
 
 void VideoPlayer::Cleanup() {
     m_isPlaying = false;
     m_isLoaded  = false;
 
-    if (m_textureId) {
-        glDeleteTextures(1, &m_textureId);
-        m_textureId = 0;
-    }
-    if (m_buffer) {
-        av_free(m_buffer);
-        m_buffer = nullptr;
+    StopPipeline();
+
+    m_frameCache.Clear();
+    m_keyframeIndex  = KeyframeIndex{};
+    m_indexReady     = false;
+    m_seekKeyframe   = -1.0;
+    m_pipelineStale  = false;
+    m_decodeTarget   = 0.0;
+    m_lastDecodedPts = -1.0;
+
+    m_renderer.Release();
+    for (auto& slot : m_frames) {
+        if (slot.frame) av_frame_free(&slot.frame);
     }
     if (m_swsCtx) {
         sws_freeContext(m_swsCtx);
         m_swsCtx = nullptr;
     }
-    if (m_rgbFrame) {
-        av_frame_free(&m_rgbFrame);
-        m_rgbFrame = nullptr;
-    }
     if (m_frame) {
         av_frame_free(&m_frame);
         m_frame = nullptr;
     }
+    if (m_swFrame) {
+        av_frame_free(&m_swFrame);
+        m_swFrame = nullptr;
+    }
     if (m_codecCtx) {
         avcodec_free_context(&m_codecCtx);
         m_codecCtx = nullptr;
@@ -263,4 +505,4 @@ void VideoPlayer::Cleanup() {
         avformat_close_input(&m_formatCtx);
         m_formatCtx = nullptr;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,373 @@
+#include "core/media/YuvRenderer.h"
+
+#include <iostream>
+#include <glad/glad.h>
+
+namespace {
+    constexpr const char* kVertexShader = R"(#version 330 core
+out vec2 vUv;
+void main() {
+    // Fullscreen triangle, no vertex buffer needed
+    vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    vUv = pos;
+    gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+    // Plane row 0 lands at v = 0, which is what ImGui::Image samples at the top edge
+    constexpr const char* kFragmentShader = R"(#version 330 core
+in vec2 vUv;
+out vec4 fragColor;
+uniform sampler2D uPlane0;
+uniform sampler2D uPlane1;
+uniform sampler2D uPlane2;
+uniform int   uLayout;   // 0 = Y/U/V planes, 1 = Y + interleaved UV
+uniform float uScale;
+uniform mat3  uMatrix;
+uniform vec3  uOffset;
+void main() {
+    vec3 yuv;
+    yuv.x = texture(uPlane0, vUv).r;
+    if (uLayout == 0) {
+        yuv.y = texture(uPlane1, vUv).r;
+        yuv.z = texture(uPlane2, vUv).r;
+    } else {
+        yuv.yz = texture(uPlane1, vUv).rg;
+    }
+    yuv = yuv * uScale - uOffset;
+    fragColor = vec4(clamp(uMatrix * yuv, 0.0, 1.0), 1.0);
+}
+)";
+
+    GLuint CompileShader(const GLenum type, const char* source) {
+        const GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, nullptr);
+        glCompileShader(shader);
+
+        GLint ok = GL_FALSE;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (!ok) {
+            char log[512];
+            glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            std::cerr << "[YuvRenderer] Shader compile failed: " << log << std::endl;
+            glDeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+
+    GLuint CreatePlaneTexture() {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        return texture;
+    }
+
+    void PlaneTextureFormat(const int channels, const bool is16Bit,
+                            GLint& internalFormat, GLenum& format, GLenum& type) {
+        format = channels == 2 ? GL_RG : GL_RED;
+        type   = is16Bit ? GL_UNSIGNED_SHORT : GL_UNSIGNED_BYTE;
+        if (channels == 2) internalFormat = is16Bit ? GL_RG16 : GL_RG8;
+        else               internalFormat = is16Bit ? GL_R16 : GL_R8;
+    }
+}
+
+YuvRenderer::~YuvRenderer() {
+    Release();
+}
+
+bool YuvRenderer::Init(const int width, const int height) {
+    Release();
+    m_width  = width;
+    m_height = height;
+
+    if (!CompileProgram()) return false;
+
+    glGenVertexArrays(1, &m_vao);
+
+    glGenTextures(1, &m_outputTexture);
+    glBindTexture(GL_TEXTURE_2D, m_outputTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint prevFbo = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFbo);
+    glGenFramebuffers(1, &m_fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_outputTexture, 0);
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFbo));
+
+    if (!complete) {
+        std::cerr << "[YuvRenderer] Framebuffer incomplete" << std::endl;
+        Release();
+        return false;
+    }
+
+    for (auto& texture : m_planeTextures)
+        texture = CreatePlaneTexture();
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return true;
+}
+
+void YuvRenderer::Release() {
+    if (m_fbo)           { glDeleteFramebuffers(1, &m_fbo);         m_fbo = 0; }
+    if (m_outputTexture) { glDeleteTextures(1, &m_outputTexture);   m_outputTexture = 0; }
+    if (m_vao)           { glDeleteVertexArrays(1, &m_vao);         m_vao = 0; }
+    if (m_program)       { glDeleteProgram(m_program);              m_program = 0; }
+    for (auto& texture : m_planeTextures) {
+        if (texture) { glDeleteTextures(1, &texture); texture = 0; }
+    }
+    m_planeFormat = -1;
+    m_planeWidth  = 0;
+    m_planeHeight = 0;
+}
+
+bool YuvRenderer::CompileProgram() {
+    const GLuint vs = CompileShader(GL_VERTEX_SHADER, kVertexShader);
+    const GLuint fs = CompileShader(GL_FRAGMENT_SHADER, kFragmentShader);
+    if (!vs || !fs) {
+        if (vs) glDeleteShader(vs);
+        if (fs) glDeleteShader(fs);
+        return false;
+    }
+
+    m_program = glCreateProgram();
+    glAttachShader(m_program, vs);
+    glAttachShader(m_program, fs);
+    glLinkProgram(m_program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(m_program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[512];
+        glGetProgramInfoLog(m_program, sizeof(log), nullptr, log);
+        std::cerr << "[YuvRenderer] Program link failed: " << log << std::endl;
+        glDeleteProgram(m_program);
+        m_program = 0;
+        return false;
+    }
+
+    GLint prevProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &prevProgram);
+    glUseProgram(m_program);
+    glUniform1i(glGetUniformLocation(m_program, "uPlane0"), 0);
+    glUniform1i(glGetUniformLocation(m_program, "uPlane1"), 1);
+    glUniform1i(glGetUniformLocation(m_program, "uPlane2"), 2);
+    glUseProgram(static_cast<GLuint>(prevProgram));
+
+    m_locLayout = glGetUniformLocation(m_program, "uLayout");
+    m_locScale  = glGetUniformLocation(m_program, "uScale");
+    m_locMatrix = glGetUniformLocation(m_program, "uMatrix");
+    m_locOffset = glGetUniformLocation(m_program, "uOffset");
+    return true;
+}
+
+// ─── Formats ─────────────────────────────────────────────────────────────────
+
+bool YuvRenderer::IsSupported(const int pixelFormat) {
+    switch (pixelFormat) {
+        case AV_PIX_FMT_YUV420P:
+        case AV_PIX_FMT_YUVJ420P:
+        case AV_PIX_FMT_NV12:
+        case AV_PIX_FMT_P010LE:
+        case AV_PIX_FMT_YUV420P10LE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+YuvRenderer::FormatInfo YuvRenderer::DescribeFormat(const int pixelFormat) {
+    FormatInfo info;
+    switch (pixelFormat) {
+        case AV_PIX_FMT_YUVJ420P:
+            info.fullRange = true;
+            break;
+        case AV_PIX_FMT_NV12:
+            info.layout = PlaneLayout::SemiPlanar;
+            break;
+        case AV_PIX_FMT_P010LE:
+            // MSB-aligned, so normalised 16-bit values are already correct
+            info.layout  = PlaneLayout::SemiPlanar;
+            info.is16Bit = true;
+            break;
+        case AV_PIX_FMT_YUV420P10LE:
+            info.is16Bit    = true;
+            info.valueScale = 65535.0f / 1023.0f;
+            break;
+        default:
+            break;
+    }
+    return info;
+}
+
+// ─── Rendering ───────────────────────────────────────────────────────────────
+
+void YuvRenderer::EnsurePlaneTextures(const AVFrame* frame, const FormatInfo& info) {
+    if (m_planeFormat == frame->format
+        && m_planeWidth == frame->width && m_planeHeight == frame->height)
+        return;
+
+    m_planeFormat = frame->format;
+    m_planeWidth  = frame->width;
+    m_planeHeight = frame->height;
+
+    const int chromaW = (frame->width + 1) / 2;
+    const int chromaH = (frame->height + 1) / 2;
+
+    GLint internalFormat; GLenum format, type;
+
+    PlaneTextureFormat(1, info.is16Bit, internalFormat, format, type);
+    glBindTexture(GL_TEXTURE_2D, m_planeTextures[0]);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, frame->width, frame->height, 0, format, type, nullptr);
+
+    if (info.layout == PlaneLayout::SemiPlanar) {
+        PlaneTextureFormat(2, info.is16Bit, internalFormat, format, type);
+        glBindTexture(GL_TEXTURE_2D, m_planeTextures[1]);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, chromaW, chromaH, 0, format, type, nullptr);
+    } else {
+        for (int i = 1; i < 3; i++) {
+            glBindTexture(GL_TEXTURE_2D, m_planeTextures[i]);
+            glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, chromaW, chromaH, 0, format, type, nullptr);
+        }
+    }
+}
+
+void YuvRenderer::UploadPlane(const unsigned int texture, const uint8_t* data, const int linesize,
+                              const int width, const int height,
+                              const int channels, const bool is16Bit) const {
+    GLint internalFormat; GLenum format, type;
+    PlaneTextureFormat(channels, is16Bit, internalFormat, format, type);
+
+    const int bytesPerTexel = channels * (is16Bit ? 2 : 1);
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, linesize / bytesPerTexel);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, type, data);
+}
+
+void YuvRenderer::SetColorUniforms(const AVFrame* frame, const FormatInfo& info) const {
+    // Luma coefficients for the stream's matrix; untagged HD content is almost always BT.709
+    float kr = 0.2126f, kb = 0.0722f;
+    switch (frame->colorspace) {
+        case AVCOL_SPC_BT470BG:
+        case AVCOL_SPC_SMPTE170M:
+            kr = 0.299f;  kb = 0.114f;
+            break;
+        case AVCOL_SPC_BT2020_NCL:
+            kr = 0.2627f; kb = 0.0593f;
+            break;
+        case AVCOL_SPC_BT709:
+            break;
+        default:
+            if (frame->height < 720) { kr = 0.299f; kb = 0.114f; }
+            break;
+    }
+    const float kg = 1.0f - kr - kb;
+
+    const bool  fullRange = info.fullRange || frame->color_range == AVCOL_RANGE_JPEG;
+    const float maxValue  = info.is16Bit ? 1023.0f : 255.0f;
+    const float steps     = maxValue / 255.0f;   // 1 for 8-bit, ~4 for 10-bit
+
+    const float yScale = fullRange ? 1.0f : 255.0f / 219.0f;
+    const float cScale = fullRange ? 1.0f : 255.0f / 224.0f;
+    const float yOff   = fullRange ? 0.0f : 16.0f * steps / maxValue;
+    const float cOff   = 128.0f * steps / maxValue;
+
+    // Row-major; uploaded transposed
+    const float matrix[9] = {
+        yScale, 0.0f,                                 cScale * 2.0f * (1.0f - kr),
+        yScale, -cScale * 2.0f * kb * (1.0f - kb) / kg, -cScale * 2.0f * kr * (1.0f - kr) / kg,
+        yScale, cScale * 2.0f * (1.0f - kb),          0.0f,
+    };
+
+    glUniform1i(m_locLayout, info.layout == PlaneLayout::SemiPlanar ? 1 : 0);
+    glUniform1f(m_locScale, info.valueScale);
+    glUniformMatrix3fv(m_locMatrix, 1, GL_TRUE, matrix);
+    glUniform3f(m_locOffset, yOff, cOff, cOff);
+}
+
+void YuvRenderer::Render(const AVFrame* frame) {
+    if (!m_program || !frame || !IsSupported(frame->format)) return;
+
+    const FormatInfo info = DescribeFormat(frame->format);
+
+    // This runs mid-frame while ImGui is building draw lists, so leave GL as we found it
+    GLint prevFbo, prevProgram, prevVao, prevTexture, prevActive, prevViewport[4], prevUnpackRow, prevUnpackAlign;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFbo);
+    glGetIntegerv(GL_CURRENT_PROGRAM, &prevProgram);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &prevVao);
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &prevActive);
+    glGetIntegerv(GL_VIEWPORT, prevViewport);
+    glGetIntegerv(GL_UNPACK_ROW_LENGTH, &prevUnpackRow);
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &prevUnpackAlign);
+    const GLboolean prevBlend   = glIsEnabled(GL_BLEND);
+    const GLboolean prevScissor = glIsEnabled(GL_SCISSOR_TEST);
+    const GLboolean prevDepth   = glIsEnabled(GL_DEPTH_TEST);
+
+    glActiveTexture(GL_TEXTURE0);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &prevTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    EnsurePlaneTextures(frame, info);
+
+    const int chromaW = (frame->width + 1) / 2;
+    const int chromaH = (frame->height + 1) / 2;
+    UploadPlane(m_planeTextures[0], frame->data[0], frame->linesize[0],
+                frame->width, frame->height, 1, info.is16Bit);
+    if (info.layout == PlaneLayout::SemiPlanar) {
+        UploadPlane(m_planeTextures[1], frame->data[1], frame->linesize[1],
+                    chromaW, chromaH, 2, info.is16Bit);
+    } else {
+        UploadPlane(m_planeTextures[1], frame->data[1], frame->linesize[1],
+                    chromaW, chromaH, 1, info.is16Bit);
+        UploadPlane(m_planeTextures[2], frame->data[2], frame->linesize[2],
+                    chromaW, chromaH, 1, info.is16Bit);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    glViewport(0, 0, m_width, m_height);
+    glDisable(GL_BLEND);
+    glDisable(GL_SCISSOR_TEST);
+    glDisable(GL_DEPTH_TEST);
+
+    glUseProgram(m_program);
+    SetColorUniforms(frame, info);
+    for (int i = 0; i < 3; i++) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, m_planeTextures[i]);
+    }
+    glBindVertexArray(m_vao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    // Restore
+    for (int i = 2; i >= 1; i--) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(prevTexture));
+    glActiveTexture(static_cast<GLenum>(prevActive));
+    glBindVertexArray(static_cast<GLuint>(prevVao));
+    glUseProgram(static_cast<GLuint>(prevProgram));
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFbo));
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, prevUnpackRow);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, prevUnpackAlign);
+    if (prevBlend)   glEnable(GL_BLEND);
+    if (prevScissor) glEnable(GL_SCISSOR_TEST);
+    if (prevDepth)   glEnable(GL_DEPTH_TEST);
+}
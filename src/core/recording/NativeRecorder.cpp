@@ -1,6 +1,7 @@
 #include "core/recording/NativeRecorder.h"
 
 #include <array>
+#include <cerrno>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
@@ -8,9 +9,12 @@
 #include <ctime>
 #include <sstream>
 #include <thread>
+#include <unordered_set>
 #include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
 #include <unistd.h>
+#include <sys/inotify.h>
 #include <sys/wait.h>
 
 // ──────────────────────────────────────────────────────────────────────────
@@ -228,6 +232,56 @@ void NativeRecorder::StopRecording() {
 }
 
 // ── Save clip ──────────────────────────────────────────────────────────
+static bool IsClipName(const fs::path& path) {
+    const auto ext = path.extension();
+    if (ext != ".mp4" && ext != ".mkv") return false;
+    return path.filename().string().find(".temp.") == std::string::npos;   // remux temporaries
+}
+
+// Clip names already in dir, so rewrites of older clips (metadata embedding
+// patches them in place or renames a remux over them) aren't taken for the new one
+static std::unordered_set<std::string> ListClips(const fs::path& dir) {
+    std::unordered_set<std::string> names;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        if (IsClipName(entry.path())) names.insert(entry.path().filename().string());
+    }
+    return names;
+}
+
+// First new video file finished (closed after writing, or renamed into place)
+// in dir, or empty on timeout. Names in existing were there before the signal.
+static fs::path WaitForClipFile(const int fd, const fs::path& dir,
+                                const std::unordered_set<std::string>& existing,
+                                const std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    alignas(inotify_event) char buffer[4096];
+
+    while (true) {
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (left <= 0) return {};
+
+        pollfd pfd{ fd, POLLIN, 0 };
+        const int ready = poll(&pfd, 1, static_cast<int>(left));
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready <= 0) return {};
+
+        ssize_t length;
+        while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+            for (const char* p = buffer; p < buffer + length; ) {
+                const auto* event = reinterpret_cast<const inotify_event*>(p);
+                p += sizeof(inotify_event) + event->len;
+                if (event->len == 0 || (event->mask & IN_ISDIR)) continue;
+
+                const fs::path path = dir / event->name;
+                if (!IsClipName(path) || existing.contains(event->name)) continue;
+                return path;
+            }
+        }
+    }
+}
+
 void NativeRecorder::SaveClip() {
     if (m_saving) { printf("[NativeRecorder] Already saving\n"); return; }
     if (m_gsrPid <= 0 || !m_recording) {
@@ -238,28 +292,24 @@ void NativeRecorder::SaveClip() {
     std::thread([this]() {
         m_saving = true;
 
-        // Snapshot existing .mp4 files before save
-        std::vector<fs::path> before;
-        for (std::error_code ec; const auto& e : fs::directory_iterator(m_outputDir, ec))
-            if (e.path().extension() == ".mp4" || e.path().extension() == ".mkv")
-                before.push_back(e.path());
+        // Watch before signalling so the finished file can't slip past
+        const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0 || inotify_add_watch(fd, m_outputDir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            fprintf(stderr, "[NativeRecorder] Cannot watch %s: %s\n", m_outputDir.c_str(), strerror(errno));
+            if (fd >= 0) close(fd);
+            if (m_onClipSaved) m_onClipSaved({}, false);
+            m_saving = false;
+            return;
+        }
+
+        // Listed after the watch starts, so nothing written meanwhile goes unseen
+        const auto existing = ListClips(m_outputDir);
 
         printf("[NativeRecorder] Saving clip (SIGUSR1 → pid=%d)\n", m_gsrPid);
         kill(m_gsrPid, SIGUSR1);
 
-        // Wait up to 15s for a new file to appear
-        fs::path newFile;
-        for (int i = 0; i < 150 && newFile.empty(); i++) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            std::error_code ec2;
-            for (const auto& e : fs::directory_iterator(m_outputDir, ec2)) {
-                const auto ext = e.path().extension();
-                if (ext != ".mp4" && ext != ".mkv") continue;
-                bool found = false;
-                for (const auto& b : before) if (b == e.path()) { found = true; break; }
-                if (!found) { newFile = e.path(); break; }
-            }
-        }
+        const fs::path newFile = WaitForClipFile(fd, m_outputDir, existing, std::chrono::seconds(15));
+        close(fd);
 
         if (newFile.empty()) {
             fprintf(stderr, "[NativeRecorder] Clip save timeout — no new file appeared\n");
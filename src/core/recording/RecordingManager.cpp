@@ -36,7 +36,13 @@ void RecordingManager::StartRecording() {
     m_nativeRecorder->SetClipDuration(m_clipDuration);
     m_nativeRecorder->SetOnClipSaved([this](const fs::path& p, const bool ok) {
         printf("[RecordingManager] Clip %s: %s\n", ok ? "saved" : "FAIL", p.c_str());
-        if (ok && m_onClipSaved) m_onClipSaved(p);
+
+        if (!ok) {
+            m_statusLines.Post("Clip could not be saved");
+            return;
+        }
+        std::lock_guard lock(m_savedClipsMutex);
+        m_savedClips.push_back(p);
     });
 
     if (m_nativeRecorder->StartRecording())
@@ -66,12 +72,13 @@ bool RecordingManager::IsSavingClip() const {
     return m_nativeRecorder && m_nativeRecorder->IsSaving();
 }
 
-void RecordingManager::SetOnClipSaved(std::function<void(const fs::path&)> cb) {
-    m_onClipSaved = std::move(cb);
+std::vector<fs::path> RecordingManager::TakeSavedClips() {
+    std::lock_guard lock(m_savedClipsMutex);
+    return std::exchange(m_savedClips, {});
 }
 
 // ─── ApplyConfig ──────────────────────────────────────────────────────────────
-void RecordingManager::ApplyConfig() const {
+void RecordingManager::ApplyConfig() {
     const Config* cfg = CoreServices::Instance().GetConfig();
     if (!cfg || !m_nativeRecorder) return;
 
@@ -113,8 +120,10 @@ void RecordingManager::ApplyConfig() const {
 
     // Output
     r->SetOutputDirectory(cfg->libraryPath);
-    r->SetStatusCallback([](const std::string& s) {
+    r->SetStatusCallback([this](const std::string& s) {
         printf("[RecordingManager] %s\n", s.c_str());
+
+        m_statusLines.Post(s);
     });
 
     printf("[NativeRecorder] Audio tracks configured: %zu\n", cfg->nativeAudioTracks.size());
@@ -23,6 +23,7 @@ void ExportWidget::Reset() {
     m_exporter->Reset();
     strcpy(m_outputFilename, "");
     m_selectedQuality = ExportQuality::ORIGINAL;
+    m_pendingLogs.Clear();
     m_exportLogs.clear();
     m_lastProgress = 0.0f;
     m_initialized = false;
@@ -31,6 +32,8 @@ void ExportWidget::Reset() {
 void ExportWidget::Draw(const EditingScreen* parent) {
     if (!parent) return;
 
+    m_pendingLogs.Drain([this](const std::string& message) { AddLog(message); });
+
     DrawDimBackground();
 
     const VideoInfo& video = parent->GetManager()->GetSelectedVideo();
@@ -192,8 +195,9 @@ void ExportWidget::Draw(const EditingScreen* parent) {
                     case ExportQuality::ORIGINAL:   settings.maxSizeMB = 0; break;
                 }
 
+                // Runs on the export thread
                 auto logCallback = [this](const std::string& msg) {
-                    AddLog(msg);
+                    m_pendingLogs.Post(msg);
                 };
 
                 m_exporter->StartExport(settings, nullptr, nullptr, logCallback);
@@ -235,8 +239,8 @@ std::string ExportWidget::GenerateDefaultFilename(const std::string& inputFilena
 void ExportWidget::AddLog(const std::string& message) {
     m_exportLogs.push_back(message);
 
-    if (m_exportLogs.size() > 100) {
-        m_exportLogs.erase(m_exportLogs.begin());
+    if (m_exportLogs.size() > kMaxLogs) {
+        m_exportLogs.pop_front();
     }
 }
 
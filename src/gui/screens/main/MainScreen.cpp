@@ -1,12 +1,14 @@
 #include "gui/screens/main/MainScreen.h"
 
 #include "gui/Theme.h"
+#include "gui/utils/FormatUtils.h"
 #include "core/CoreServices.h"
 #include "core/library/LibraryLoader.h"
 #include "core/library/VideoLibrary.h"
 
 #include "imgui.h"
 
+#include <algorithm>
 #include <cmath>
 #include <filesystem>
 #include <sys/statvfs.h>
@@ -29,6 +31,12 @@ MainScreen::MainScreen(MainWindow* manager)
     DetermineInitialState();
 }
 
+MainScreen::~MainScreen() {
+    if (auto* watcher = CoreServices::Instance().GetLibraryWatcher()) {
+        watcher->SetOnChanged(nullptr);
+    }
+}
+
 std::filesystem::path MainScreen::GetCurrentFolder() const {
     const auto* config = CoreServices::Instance().GetConfig();
     if (config && !config->libraryPath.empty())
@@ -36,6 +44,56 @@ std::filesystem::path MainScreen::GetCurrentFolder() const {
     return {};
 }
 
+size_t MainScreen::GetLibrarySize() const {
+    // The totals can run ahead of the rows while a write is in flight
+    return m_allPagesLoaded ? m_libraryTable.Size() : std::max(m_librarySize, m_libraryTable.Size());
+}
+
+bool MainScreen::LoadNextPage() {
+    const auto* library = CoreServices::Instance().GetVideoLibrary();
+    if (!library || m_allPagesLoaded) return false;
+
+    const auto page = library->GetGridPage(m_pageCursor, kGridPageSize);
+    if (page.size() < kGridPageSize) m_allPagesLoaded = true;
+    if (page.empty()) return false;
+
+    for (const auto& video : page) {
+        m_libraryTable.Append(video);
+
+        VideoDisplayText text;
+        text.date       = FormatUtils::FormatDate(video.recordingTimeMs);
+        text.duration   = FormatUtils::FormatDuration(video.durationSec);
+        text.resolution = std::to_string(video.resolutionWidth) + "x" + std::to_string(video.resolutionHeight);
+        m_videoDisplayText.push_back(std::move(text));
+    }
+
+    m_pageCursor = VideoPageCursor{page.back().recordingTimeMs, page.back().filePathString};
+    return true;
+}
+
+void MainScreen::EnsureRowsLoaded(const size_t rowCount) {
+    while (m_libraryTable.Size() < rowCount && LoadNextPage()) {}
+}
+
+void MainScreen::ResetLibraryView() {
+    const auto* library = CoreServices::Instance().GetVideoLibrary();
+
+    m_libraryTable = LibraryTable();
+    m_videoDisplayText.clear();
+    m_pageCursor.reset();
+    m_allPagesLoaded = false;
+    m_librarySize    = library ? library->GetStatistics().totalVideos : 0;
+
+    LoadNextPage();
+    m_videoListState->RequestThumbnailReload();
+
+    std::cout << "[MainScreen] Library: " << m_librarySize << " videos, first "
+              << m_libraryTable.Size() << " loaded\n";
+
+    // Clips were added or removed: free space moved with them
+    m_storageStale = true;
+}
+
 void MainScreen::DetermineInitialState() {
     // Each time the screen appears, it checks the path in the config.
     // If no path is specified in the config, the screen is set to WelcomeState.
@@ -44,10 +102,15 @@ void MainScreen::DetermineInitialState() {
         return;
     }
 
-    if (auto* recMgr = CoreServices::Instance().GetRecordingManager()) {
-        recMgr->SetOnClipSaved([this](const fs::path&) {
-            RefreshLibrarySilent();
+    // Saved clips and anything else dropped into the folder arrive through the
+    // watcher, already synced; without it, sync each saved clip ourselves
+    if (auto* watcher = CoreServices::Instance().GetLibraryWatcher(); watcher && watcher->IsRunning()) {
+        watcher->SetOnChanged([this](const fs::path&) {
+            m_libraryChanged = true;
         });
+        m_syncSavedClips = false;
+    } else {
+        m_syncSavedClips = true;
     }
 
     StartLibraryLoad();
@@ -103,44 +166,75 @@ void MainScreen::StartLibraryLoad() {
 
     // It takes the file path from the library path section in the config and moves it to the Loading screen.
     std::thread([this, library, config]() {
-        library->CleanupOrphanedRecords();
-
         LibraryLoader::Run(library, config->libraryPath,
             [this](const std::string& msg, const float progress) {
                 m_loadingState->AddLog(msg, progress);
-                m_loadingState->SetProgress(progress);
             }
         );
 
         // It scans and records videos in the folder. If they are in the database, it skips them.
-        const auto videos = library->GetAllVideos();
-        this->SetCurrentVideos(videos);
+        m_libraryLoaded = true;
 
-        ChangeState(videos.empty() ? MainScreenState::EMPTY_FOLDER : MainScreenState::VIDEO_LIST);
-        std::cout << "[MainScreen] Loaded " << videos.size() << " videos\n";
+        // The grid is up; thumbnails and integrity catch up behind it
+        LibraryLoader::RunMaintenance(library);
+        m_libraryChanged = true;
     }).detach();
 }
 
-void MainScreen::RefreshLibrarySilent() {
+void MainScreen::RefreshLibrarySilent(const std::filesystem::path& changedFile) {
     auto& services     = CoreServices::Instance();
     auto* library      = services.GetVideoLibrary();
     const auto* config = services.GetConfig();
 
     if (!library || !config) return;
 
-    std::thread([this, library, config]() {
-        LibraryLoader::Run(library, config->libraryPath, nullptr);
-
-        const auto videos = library->GetAllVideos();
-        this->SetCurrentVideos(videos);
+    std::thread([this, library, config, changedFile]() {
+        // A saved clip only needs itself synced, not the whole folder
+        if (changedFile.empty()) {
+            LibraryLoader::Run(library, config->libraryPath, nullptr);
+            m_libraryChanged = true;
+            LibraryLoader::RunMaintenance(library);
+        } else {
+            LibraryLoader::SyncFile(library, changedFile.string(), nullptr);
+        }
 
-        m_videoListState->RequestThumbnailReload();
-        ChangeState(videos.empty() ? MainScreenState::EMPTY_FOLDER : MainScreenState::VIDEO_LIST);
+        m_libraryChanged = true;
     }).detach();
 }
 
+void MainScreen::DrainEvents() {
+    // A change during the initial load is picked up when it finishes
+    const bool loaded  = m_libraryLoaded.exchange(false);
+    const bool changed = m_currentState != MainScreenState::LOADING && m_libraryChanged.exchange(false);
+    if (loaded || changed) {
+        m_libraryChanged = false;
+        ReloadVideoList();
+    }
+
+    // The top bar owns the recording manager; before it shows, nothing has started one
+    if (m_currentState != MainScreenState::VIDEO_LIST && m_currentState != MainScreenState::EMPTY_FOLDER) return;
+
+    if (auto* recMgr = CoreServices::Instance().GetRecordingManager()) {
+        recMgr->DrainStatus([this](std::string status) { m_recordingStatus = std::move(status); });
+
+        for (const auto& clipPath : recMgr->TakeSavedClips()) {
+            if (m_syncSavedClips) RefreshLibrarySilent(clipPath);
+        }
+    }
+}
+
+void MainScreen::ReloadVideoList() {
+    auto* library = CoreServices::Instance().GetVideoLibrary();
+    if (!library) return;
+
+    ResetLibraryView();
+    ChangeState(m_libraryTable.Empty() ? MainScreenState::EMPTY_FOLDER : MainScreenState::VIDEO_LIST);
+}
+
 // ─── Draw ─────────────────────────────────────────────────────────────────
 void MainScreen::Draw() {
+    DrainEvents();
+
     constexpr ImGuiWindowFlags flags =
         ImGuiWindowFlags_NoDecoration |
         ImGuiWindowFlags_NoResize     |
@@ -212,7 +306,7 @@ void MainScreen::DrawTopBar() {
     ImGui::PopStyleVar();
 
     const auto* config     = CoreServices::Instance().GetConfig();
-    const StorageInfo info = CalculateStorageInfo(config->libraryPath, m_currentVideos.size());
+    const StorageInfo& info = SampleStorageInfo(config->libraryPath);
 
     // ── Storage info (left, vertically centered) ──────────────────────────────
     ImGui::SetCursorPosY((Theme::TOPBAR_H - ImGui::GetTextLineHeight()) * 0.5f);
@@ -276,6 +370,8 @@ void MainScreen::DrawRecordToggleButton() {
             else             recMgr->StartRecording();
         }
     }
+    if (ImGui::IsItemHovered() && !m_recordingStatus.empty())
+        ImGui::SetTooltip("%s", m_recordingStatus.c_str());
     ImGui::PopStyleColor(3);
 
     constexpr float radius = 5.0f;
@@ -358,6 +454,18 @@ void MainScreen::DrawStorageInfo(const StorageInfo& info) {
     ImGui::PopStyleColor();
 }
 
+const StorageInfo& MainScreen::SampleStorageInfo(const std::string& libraryPath) {
+    const auto now = std::chrono::steady_clock::now();
+    if (m_storageStale || now - m_storageSampledAt >= kStorageSampleInterval) {
+        m_storageStale     = false;
+        m_storageInfo      = CalculateStorageInfo(libraryPath, GetLibrarySize());
+        m_storageSampledAt = now;
+    }
+
+    m_storageInfo.totalVideos = GetLibrarySize();
+    return m_storageInfo;
+}
+
 StorageInfo MainScreen::CalculateStorageInfo(const std::string& libraryPath, size_t videoCount) {
     StorageInfo info;
     info.totalVideos = videoCount;
@@ -5,6 +5,12 @@
 #include <iomanip>
 
 void LoadingState::Draw(MainScreen*) {
+    m_pendingLogs.Drain([this](LoadingLog log) {
+        m_progress = log.progress;
+        m_logs.push_back(std::move(log));
+        if (m_logs.size() > kMaxLogs) m_logs.pop_front();
+    });
+
     const ImVec2 avail = ImGui::GetContentRegionAvail();
 
     ImGui::SetCursorPos(ImVec2(avail.x * 0.5f - 80, avail.y * 0.28f));
@@ -28,38 +34,35 @@ void LoadingState::Draw(MainScreen*) {
         ImGuiWindowFlags_AlwaysVerticalScrollbar);
     ImGui::PopStyleColor();
 
-    {
-        std::lock_guard lock(m_logMutex);
-        for (const auto& [message, progress, timestamp] : m_logs) {
-            auto tt = std::chrono::system_clock::to_time_t(timestamp);
-            std::stringstream ss;
-            ss << std::put_time(std::localtime(&tt), "%H:%M:%S");
+    for (const auto& [message, progress, timestamp] : m_logs) {
+        auto tt = std::chrono::system_clock::to_time_t(timestamp);
+        std::stringstream ss;
+        ss << std::put_time(std::localtime(&tt), "%H:%M:%S");
 
-            ImGui::PushStyleColor(ImGuiCol_Text, Theme::TEXT_MUTED);
-            ImGui::TextUnformatted(ss.str().c_str());
-            ImGui::PopStyleColor();
-            ImGui::SameLine();
+        ImGui::PushStyleColor(ImGuiCol_Text, Theme::TEXT_MUTED);
+        ImGui::TextUnformatted(ss.str().c_str());
+        ImGui::PopStyleColor();
+        ImGui::SameLine();
 
-            if (progress >= 1.0f) {
-                ImGui::PushStyleColor(ImGuiCol_Text, Theme::SUCCESS);
-                ImGui::TextUnformatted("✓");
-            } else if (progress < 0.0f) {
-                ImGui::PushStyleColor(ImGuiCol_Text, Theme::DANGER);
-                ImGui::TextUnformatted("✗");
-            } else {
-                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.8f, 0.2f, 1.0f));
-                ImGui::TextUnformatted("⏳");
-            }
-            ImGui::PopStyleColor();
+        if (progress >= 1.0f) {
+            ImGui::PushStyleColor(ImGuiCol_Text, Theme::SUCCESS);
+            ImGui::TextUnformatted("✓");
+        } else if (progress < 0.0f) {
+            ImGui::PushStyleColor(ImGuiCol_Text, Theme::DANGER);
+            ImGui::TextUnformatted("✗");
+        } else {
+            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.8f, 0.2f, 1.0f));
+            ImGui::TextUnformatted("⏳");
+        }
+        ImGui::PopStyleColor();
 
-            ImGui::SameLine();
-            ImGui::PushStyleColor(ImGuiCol_Text, Theme::TEXT_PRIMARY);
-            ImGui::TextUnformatted(message.c_str());
-            ImGui::PopStyleColor();
+        ImGui::SameLine();
+        ImGui::PushStyleColor(ImGuiCol_Text, Theme::TEXT_PRIMARY);
+        ImGui::TextUnformatted(message.c_str());
+        ImGui::PopStyleColor();
 
-            if (progress >= 0.0f && progress < 1.0f)
-                ImGui::ProgressBar(progress, ImVec2(-1, 0));
-        }
+        if (progress >= 0.0f && progress < 1.0f)
+            ImGui::ProgressBar(progress, ImVec2(-1, 0));
     }
 
     if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
@@ -69,18 +72,15 @@ void LoadingState::Draw(MainScreen*) {
 }
 
 void LoadingState::AddLog(const std::string& message, float progress) {
-    std::lock_guard lock(m_logMutex);
     LoadingLog log;
     log.message   = message;
     log.progress  = progress;
     log.timestamp = std::chrono::system_clock::now();
-    m_logs.push_back(log);
-    if (m_logs.size() > 100)
-        m_logs.erase(m_logs.begin());
+    m_pendingLogs.Post(std::move(log));
 }
 
 void LoadingState::Clear() {
-    std::lock_guard lock(m_logMutex);
+    m_pendingLogs.Clear();
     m_logs.clear();
     m_progress = 0.0f;
 }
\ No newline at end of file
@@ -1,11 +1,10 @@
 #include "gui/screens/main/states/VideoListState.h"
 
 #include "gui/Theme.h"
-#include "gui/utils/ThumbnailLoader.h"
-#include "gui/utils/FormatUtils.h"
 #include "gui/screens/main/MainScreen.h"
+#include "core/CoreServices.h"
+#include "core/library/VideoLibrary.h"
 #include "core/recording/RecordingManager.h"
-#include "core/VideoInfo.h"
 
 #include <algorithm>
 
@@ -14,7 +13,7 @@ MainWindow* VideoListState::GetMainWindow(const MainScreen* parent) {
 }
 
 void VideoListState::Draw(MainScreen* parent) {
-    if (!m_thumbnailsLoaded) {
+    if (!m_thumbnailsLoaded || m_thumbnailSources.size() > parent->GetLibraryTable().Size()) {
         LoadThumbnails(parent);
         m_thumbnailsLoaded = true;
     }
@@ -28,7 +27,8 @@ void VideoListState::Draw(MainScreen* parent) {
 
 void VideoListState::DrawVideoGrid(MainScreen* parent) {
     const ImVec2 avail = ImGui::GetContentRegionAvail();
-    const auto& videos = parent->GetCurrentVideos();
+    const auto& table  = parent->GetLibraryTable();
+    const auto& labels = parent->GetVideoDisplayText();
 
     constexpr float thumbnailSize = 200.0f;
     constexpr float padding = 15.0f;
@@ -36,80 +36,151 @@ void VideoListState::DrawVideoGrid(MainScreen* parent) {
     constexpr float totalItemWidth = thumbnailSize;
 
     const int columns = std::max(1, static_cast<int>(avail.x / (totalItemWidth + padding)));
+    // Sized for the whole library so the scrollbar is right; pages load as rows come into view
+    const size_t total = parent->GetLibrarySize();
+    const int rows     = static_cast<int>((total + columns - 1) / columns);
 
-    ImGui::BeginChild("VideoGrid", ImVec2(0, 0), false);
+    // Every tile is the same height (single-line name), so rows can be clipped
+    // without measuring: thumbnail + name + date/duration + resolution + padding
+    const float rowHeight = tHeight + ImGui::GetStyle().ItemSpacing.y
+                          + 3.0f * ImGui::GetTextLineHeightWithSpacing() + padding;
 
-    int currentPos = 0;
+    ImGui::BeginChild("VideoGrid", ImVec2(0, 0), false);
 
-    for (size_t i = 0; i < videos.size(); i++) {
-        ImGui::PushID(static_cast<int>(i));
-        auto& video = videos[i];
+    ImGuiListClipper clipper;
+    clipper.Begin(rows, rowHeight);
 
-        ImGui::BeginGroup();
+    int firstRow = rows;
+    int lastRow  = 0;
 
-        // Thumbnail
-        if (video.thumbnailId) {
-            ImGui::Image(video.thumbnailId, ImVec2(thumbnailSize, tHeight));
-        } else {
-            ImVec2 pMin = ImGui::GetCursorScreenPos();
-            auto pMax = ImVec2(pMin.x + thumbnailSize, pMin.y + tHeight);
-            ImGui::GetWindowDrawList()->AddRectFilled(pMin, pMax, ImGui::GetColorU32(Theme::BG_DARK), 8.0f);
+    while (clipper.Step()) {
+        firstRow = std::min(firstRow, clipper.DisplayStart);
+        lastRow  = std::max(lastRow, clipper.DisplayEnd);
 
-            ImGui::SetCursorScreenPos(ImVec2(pMin.x + 10, pMin.y + tHeight * 0.4f));
-            ImGui::PushStyleColor(ImGuiCol_Text, Theme::TEXT_MUTED);
-            ImGui::TextDisabled("  Generating\n Thumbnail...");
+        parent->EnsureRowsLoaded(static_cast<size_t>(clipper.DisplayEnd) * columns);
+        ResolveNewThumbnails(parent);
 
-            ImGui::Dummy(ImVec2(thumbnailSize, tHeight));
-        }
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            const ImVec2 rowStart = ImGui::GetCursorPos();
 
-        ImGui::PushTextWrapPos(ImGui::GetCursorPos().x + thumbnailSize);
-        ImGui::TextWrapped("%s", video.name.c_str());
+            for (int column = 0; column < columns; column++) {
+                const size_t i = static_cast<size_t>(row) * columns + column;
+                if (i >= table.Size()) break;
 
-        std::string dateStr = FormatUtils::FormatDate(video.recordingTimeMs);
-        ImGui::TextColored(Theme::TEXT_MUTED, "%s", dateStr.c_str());
+                ImGui::SetCursorPos(ImVec2(rowStart.x + column * (totalItemWidth + padding), rowStart.y));
+                DrawVideoTile(parent, table, static_cast<LibraryTable::RowId>(i),
+                              i < labels.size() ? &labels[i] : nullptr, thumbnailSize, tHeight);
+            }
 
-        std::string durationStr = FormatUtils::FormatDuration(video.durationSec);
-        ImGui::SameLine();
-        ImGui::TextColored(Theme::TEXT_MUTED, "| %s", durationStr.c_str());
+            // Reserve the whole row so the clipper's spacing matches rowHeight
+            ImGui::SetCursorPos(rowStart);
+            ImGui::Dummy(ImVec2(avail.x, rowHeight - ImGui::GetStyle().ItemSpacing.y));
+        }
+    }
+    clipper.End();
+
+    // One screen of rows either side is prefetched, not drawn; the page
+    // below is read now so scrolling into it doesn't wait on SQLite
+    const int prefetchRows = std::max(1, lastRow - firstRow);
+    parent->EnsureRowsLoaded(static_cast<size_t>(lastRow + prefetchRows) * columns);
+    ResolveNewThumbnails(parent);
+
+    const auto prefetch = [&](const int beginRow, const int endRow) {
+        for (int row = std::max(0, beginRow); row < std::min(rows, endRow); row++) {
+            for (int column = 0; column < columns; column++) {
+                const size_t i = static_cast<size_t>(row) * columns + column;
+                if (i >= table.Size()) break;
+                m_thumbnailStreamer.Request(m_thumbnailSources[i].image, false);
+            }
+        }
+    };
+    if (firstRow < lastRow) {
+        prefetch(firstRow - prefetchRows, firstRow);
+        prefetch(lastRow, lastRow + prefetchRows);
+    }
 
-        ImGui::TextColored(Theme::TEXT_MUTED,
-                          "%dx%d", video.resolutionWidth, video.resolutionHeight);
+    ImGui::EndChild();
 
-        ImGui::PopTextWrapPos();
-        ImGui::EndGroup();
+    m_thumbnailStreamer.EndFrame();
+}
 
-        if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(0)) {
-            if (MainWindow* mainWindow = GetMainWindow(parent)) {
-                mainWindow->SwitchToEditingScreen(video);
-            }
-        }
+void VideoListState::DrawVideoTile(MainScreen* parent, const LibraryTable& table,
+                                   const LibraryTable::RowId row, const VideoDisplayText* label,
+                                   const float thumbnailSize, const float tHeight) {
+    ImGui::PushID(static_cast<int>(row));
+    ImGui::BeginGroup();
+
+    // Thumbnail
+    const ThumbnailSource& source = m_thumbnailSources[row];
+
+    if (const ImTextureID thumbnail = m_thumbnailStreamer.Request(source.image)) {
+        ImGui::Image(thumbnail, ImVec2(thumbnailSize, tHeight), source.uv0, source.uv1);
+    } else {
+        ImVec2 pMin = ImGui::GetCursorScreenPos();
+        auto pMax = ImVec2(pMin.x + thumbnailSize, pMin.y + tHeight);
+        ImGui::GetWindowDrawList()->AddRectFilled(pMin, pMax, ImGui::GetColorU32(Theme::BG_DARK), 8.0f);
+
+        ImGui::SetCursorScreenPos(ImVec2(pMin.x + 10, pMin.y + tHeight * 0.4f));
+        ImGui::PushStyleColor(ImGuiCol_Text, Theme::TEXT_MUTED);
+        ImGui::TextDisabled("  Generating\n Thumbnail...");
+        ImGui::PopStyleColor();
+
+        ImGui::SetCursorScreenPos(pMin);
+        ImGui::Dummy(ImVec2(thumbnailSize, tHeight));
+    }
 
-        // Context menu
-        char popupID[64];
-        snprintf(popupID, sizeof(popupID), "VideoContext##%zu", i);
+    // Name is clipped to the tile width so every tile has the same height
+    const ImVec2 namePos = ImGui::GetCursorScreenPos();
+    ImGui::PushClipRect(namePos,
+                        ImVec2(namePos.x + thumbnailSize, namePos.y + ImGui::GetTextLineHeightWithSpacing()),
+                        true);
+    const std::string_view name = table.GetName(row);
+    ImGui::TextUnformatted(name.data(), name.data() + name.size());
+    ImGui::PopClipRect();
+
+    if (label) {
+        ImGui::TextColored(Theme::TEXT_MUTED, "%s", label->date.c_str());
+        ImGui::SameLine();
+        ImGui::TextColored(Theme::TEXT_MUTED, "| %s", label->duration.c_str());
+        ImGui::TextColored(Theme::TEXT_MUTED, "%s", label->resolution.c_str());
+    }
 
-        if (ImGui::BeginPopupContextItem(popupID)) {
-            if (ImGui::MenuItem("Edit")) {}
-            if (ImGui::MenuItem("Properties")) {}
-            ImGui::Separator();
-            if (ImGui::MenuItem("Delete")) {}
-            ImGui::EndPopup();
-        }
+    ImGui::EndGroup();
 
-        // Grid layout
-        currentPos++;
-        if (currentPos % columns != 0 && (i < videos.size() - 1)) {
-            ImGui::SameLine(0, padding);
-        } else {
-            ImGui::Dummy(ImVec2(0, padding));
+    if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(0)) {
+        // The editor gets the full record; the table only carries what the grid shows
+        const auto* library = CoreServices::Instance().GetVideoLibrary();
+        const auto video    = library ? library->GetVideo(table.GetPath(row)) : nullptr;
+        if (MainWindow* mainWindow = GetMainWindow(parent); mainWindow && video) {
+            mainWindow->SwitchToEditingScreen(*video);
         }
+    }
 
-        ImGui::PopID();
+    // Context menu
+    if (ImGui::BeginPopupContextItem("VideoContext")) {
+        if (ImGui::MenuItem("Edit")) {}
+        if (ImGui::MenuItem("Properties")) {}
+        ImGui::Separator();
+        if (ImGui::MenuItem("Delete")) {}
+        ImGui::EndPopup();
     }
 
-    ImGui::EndChild();
+    ImGui::PopID();
 }
 
 void VideoListState::LoadThumbnails(MainScreen* parent) {
-    ThumbnailLoader::LoadThumbnails(parent->GetCurrentVideos());
+    // Pages may have been repacked; start from an empty texture set
+    m_thumbnailStreamer.Clear();
+    m_thumbnailSources.clear();
+    m_atlases.clear();
+    ResolveNewThumbnails(parent);
+}
+
+void VideoListState::ResolveNewThumbnails(const MainScreen* parent) {
+    const auto& table = parent->GetLibraryTable();
+    if (m_thumbnailSources.size() >= table.Size()) return;
+
+    auto added = ThumbnailLoader::ResolveSources(table, m_atlases, static_cast<LibraryTable::RowId>(m_thumbnailSources.size()));
+    m_thumbnailSources.insert(m_thumbnailSources.end(),
+                              std::make_move_iterator(added.begin()), std::make_move_iterator(added.end()));
 }
\ No newline at end of file
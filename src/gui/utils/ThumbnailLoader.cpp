@@ -1,6 +1,7 @@
 #include "gui/utils/ThumbnailLoader.h"
-#include "core/VideoInfo.h"
+#include "core/library/LibraryTable.h"
 #include <GL/gl.h>
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 
@@ -22,6 +23,16 @@ ImTextureID ThumbnailLoader::LoadFromFile(const char* filename) {
         return 0;
     }
 
+    const ImTextureID texture = CreateTexture(data, width, height);
+    stbi_image_free(data);
+
+    std::cout << "✓ Loaded thumbnail: " << filename
+              << " (" << width << "x" << height << ")" << std::endl;
+
+    return texture;
+}
+
+ImTextureID ThumbnailLoader::CreateTexture(const unsigned char* rgba, const int width, const int height) {
     GLuint textureID;
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
@@ -31,12 +42,7 @@ ImTextureID ThumbnailLoader::LoadFromFile(const char* filename) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-
-    stbi_image_free(data);
-
-    std::cout << "✓ Loaded thumbnail: " << filename
-              << " (" << width << "x" << height << ")" << std::endl;
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
 
     return (ImTextureID)(intptr_t)textureID;
 }
@@ -48,41 +54,33 @@ void ThumbnailLoader::FreeTexture(ImTextureID texture) {
     }
 }
 
-void ThumbnailLoader::LoadThumbnails(std::vector<VideoInfo>& videos) {
-    std::cout << "Loading thumbnails for " << videos.size() << " videos..." << std::endl;
-
-    int loaded = 0;
-    int failed = 0;
-
-    for (auto& video : videos) {
-        if (!video.thumbnailPath.empty()) {
-            video.thumbnailId = LoadFromFile(video.thumbnailPath.c_str());
+std::vector<ThumbnailSource> ThumbnailLoader::ResolveSources(const LibraryTable& table,
+                                                             ThumbnailAtlasCache& atlases,
+                                                             const uint32_t firstRow) {
+    std::vector<ThumbnailSource> sources(table.Size() - std::min<size_t>(firstRow, table.Size()));
+
+    for (LibraryTable::RowId row = firstRow; row < table.Size(); row++) {
+        if (!table.HasThumbnail(row)) continue;
+        const std::string thumbnailPath = table.GetThumbnailPath(row);
+        auto& source = sources[row - firstRow];
+
+        const auto folder = std::filesystem::path(thumbnailPath).parent_path();
+        auto atlas = atlases.find(folder);
+        if (atlas == atlases.end()) {
+            atlas = atlases.try_emplace(folder, folder).first;
+            atlas->second.Load();
+        }
 
-            if (video.thumbnailId) {
-                loaded++;
-            } else {
-                failed++;
-                std::cerr << "✗ Failed to load: " << video.thumbnailPath << std::endl;
-            }
+        // The loader repacks before publishing videos, so the index is trusted as is
+        if (const auto tile = atlas->second.Find(thumbnailPath, false)) {
+            const auto uv = ThumbnailAtlas::GetTileUv(tile->slot);
+            source.uv0   = ImVec2(uv.u0, uv.v0);
+            source.uv1   = ImVec2(uv.u1, uv.v1);
+            source.image = atlas->second.GetPagePath(tile->page).string();
         } else {
-            std::cout << "⊘ No thumbnail path for: " << video.name << std::endl;
+            source.image = thumbnailPath;
         }
     }
 
-    std::cout << "Thumbnail loading completed: "
-              << loaded << " loaded, "
-              << failed << " failed" << std::endl;
+    return sources;
 }
-
-void ThumbnailLoader::FreeThumbnails(std::vector<VideoInfo>& videos) {
-    std::cout << "Freeing thumbnails for " << videos.size() << " videos..." << std::endl;
-
-    for (auto& video : videos) {
-        if (video.thumbnailId) {
-            FreeTexture(video.thumbnailId);
-            video.thumbnailId = 0;
-        }
-    }
-
-    std::cout << "All thumbnails freed" << std::endl;
-}
\ No newline at end of file
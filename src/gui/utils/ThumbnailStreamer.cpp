@@ -0,0 +1,177 @@
+#include "gui/utils/ThumbnailStreamer.h"
+#include "gui/utils/ThumbnailLoader.h"
+
+#include <algorithm>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include "stb_image.h"
+
+ThumbnailStreamer::ThumbnailStreamer(const size_t vramBudgetBytes)
+    : m_vramBudget(vramBudgetBytes),
+      m_worker(&ThumbnailStreamer::WorkerLoop, this) {}
+
+ThumbnailStreamer::~ThumbnailStreamer() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_quit = true;
+    }
+    m_cv.notify_all();
+    if (m_worker.joinable()) m_worker.join();
+
+    Clear();
+}
+
+ImTextureID ThumbnailStreamer::Request(const std::string& path, const bool visible) {
+    if (path.empty()) return 0;
+
+    if (const auto it = m_resident.find(path); it != m_resident.end()) {
+        it->second.lastUsed = m_frame;
+        return it->second.texture;
+    }
+    if (m_failed.contains(path)) return 0;
+
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_loading.contains(path)) return 0;
+
+        auto& request = m_pending[path];
+        if (request.frame != m_frame) request.visible = false;
+        request.frame    = m_frame;
+        request.visible |= visible;
+    }
+    m_cv.notify_one();
+    return 0;
+}
+
+void ThumbnailStreamer::EndFrame() {
+    {
+        std::lock_guard lock(m_mutex);
+        while (!m_decoded.empty()) {
+            if (m_decoded.front().generation == m_generation) {
+                m_ready.push_back(m_decoded.front());
+            } else {
+                stbi_image_free(m_decoded.front().pixels);
+            }
+            m_decoded.pop_front();
+        }
+    }
+
+    // Always take at least one so a single oversized image can't stall the queue
+    size_t uploaded = 0;
+    std::vector<std::string> done;
+
+    while (!m_ready.empty() && (uploaded == 0 || uploaded < kUploadBytesPerFrame)) {
+        DecodedImage image = m_ready.front();
+        m_ready.pop_front();
+        done.push_back(image.path);
+
+        if (!image.pixels) {
+            m_failed.insert(image.path);
+            continue;
+        }
+
+        Resident resident;
+        resident.texture  = ThumbnailLoader::CreateTexture(image.pixels, image.width, image.height);
+        resident.bytes    = static_cast<size_t>(image.width) * image.height * 4;
+        resident.lastUsed = m_frame;
+        stbi_image_free(image.pixels);
+
+        uploaded        += resident.bytes;
+        m_residentBytes += resident.bytes;
+        m_resident[image.path] = resident;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        for (const auto& path : done) m_loading.erase(path);
+        m_frame++;
+    }
+
+    Evict();
+}
+
+void ThumbnailStreamer::Evict() {
+    // Least recently drawn first; anything drawn in the frame just finished stays
+    while (m_residentBytes > m_vramBudget) {
+        auto oldest = m_resident.end();
+        for (auto it = m_resident.begin(); it != m_resident.end(); ++it) {
+            if (it->second.lastUsed + 1 >= m_frame) continue;
+            if (oldest == m_resident.end() || it->second.lastUsed < oldest->second.lastUsed)
+                oldest = it;
+        }
+        if (oldest == m_resident.end()) break;
+
+        ThumbnailLoader::FreeTexture(oldest->second.texture);
+        m_residentBytes -= oldest->second.bytes;
+        m_resident.erase(oldest);
+    }
+}
+
+void ThumbnailStreamer::Clear() {
+    for (auto& [path, resident] : m_resident) {
+        ThumbnailLoader::FreeTexture(resident.texture);
+    }
+    m_resident.clear();
+    m_failed.clear();
+    m_residentBytes = 0;
+
+    for (auto& image : m_ready) stbi_image_free(image.pixels);
+    m_ready.clear();
+
+    std::lock_guard lock(m_mutex);
+    for (auto& image : m_decoded) stbi_image_free(image.pixels);
+    m_decoded.clear();
+    m_pending.clear();
+    m_loading.clear();
+    m_generation++;   // decodes already in flight are discarded on arrival
+}
+
+// ─── Worker ──────────────────────────────────────────────────────────────────
+
+void ThumbnailStreamer::WorkerLoop() {
+    std::unique_lock lock(m_mutex);
+
+    while (true) {
+        m_cv.wait(lock, [this] { return m_quit || !m_pending.empty(); });
+        if (m_quit) return;
+
+        // Requests that weren't renewed scrolled out of view; forget them
+        std::erase_if(m_pending, [this](const auto& entry) {
+            return entry.second.frame + kStaleFrames < m_frame;
+        });
+
+        // Visible before prefetch, newest first
+        auto next = m_pending.end();
+        for (auto it = m_pending.begin(); it != m_pending.end(); ++it) {
+            if (next == m_pending.end()
+                || std::tie(it->second.frame, it->second.visible)
+                 > std::tie(next->second.frame, next->second.visible)) {
+                next = it;
+            }
+        }
+        if (next == m_pending.end()) continue;
+
+        DecodedImage image;
+        image.path       = next->first;
+        image.generation = m_generation;
+        m_pending.erase(next);
+        m_loading.insert(image.path);
+
+        lock.unlock();
+        int channels = 0;
+        image.pixels = stbi_load(image.path.c_str(), &image.width, &image.height, &channels, 4);
+        if (!image.pixels) {
+            std::cerr << "[ThumbnailStreamer] Failed to load " << image.path
+                      << ": " << stbi_failure_reason() << std::endl;
+        }
+        lock.lock();
+
+        if (image.generation == m_generation) {
+            m_decoded.push_back(std::move(image));
+        } else {
+            stbi_image_free(image.pixels);
+        }
+    }
+}